@@ -7,6 +7,52 @@
  * deadline first. */
 #define configUSE_EDF_SCHEDULER					1
 
+/* The options below only apply to the EDF scheduler.  They are left undefined,
+ * and so default to 0, when it is disabled. */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+/* Set to 1 to reject, in xTaskCreate_EDF(), any task that would make the set of
+ * EDF tasks unschedulable.  The test is exact for tasks with deadlines shorter
+ * than their periods, using the processor demand criterion. */
+#define configUSE_EDF_ADMISSION_CONTROL			1
+
+/* Set to 1 to make xSemaphoreCreateMutexSRP() available.  Under EDF, mutexes
+ * created with it are managed by the Stack Resource Policy, so a job is blocked
+ * at most once, before it starts, rather than inside xSemaphoreTake(). */
+#define configUSE_SRP_MUTEXES					1
+
+/* Set to 1 to make vTaskSetNonPreemptiveRegion_EDF() available, so a running
+ * EDF task can defer its preemption by a job with an earlier deadline. */
+#define configUSE_EDF_LIMITED_PREEMPTION		1
+
+/* Set to 1 to treat each task priority as a band.  Bands are selected by
+ * priority, as without EDF, and only the tasks within a band are ordered by
+ * deadline, so the timer task stays above the EDF tasks. */
+#define configUSE_EDF_PRIORITY_BANDS			1
+
+/* Set to 1 to make vTaskSetElasticity_EDF() available.  Whenever the tasks
+ * would use more than configEDF_ELASTIC_UTILISATION percent of the processor at
+ * their nominal periods, the periods of elastic tasks are stretched, in
+ * proportion to their elastic coefficients, until they do not. */
+#define configUSE_EDF_ELASTIC_TASKS				1
+#define configEDF_ELASTIC_UTILISATION			100
+
+/* Set to 1 to make vTaskSetMKFirm_EDF() available.  Under overload, jobs of
+ * a task with an (m,k)-firm constraint that cannot meet their deadline are
+ * skipped, as long as the constraint still holds, so the time they would have
+ * used goes to the jobs that can still meet theirs. */
+#define configUSE_EDF_MK_FIRM					1
+
+/* The policy used to order the ready tasks: edfPOLICY_EDF, edfPOLICY_RM,
+ * edfPOLICY_DM or edfPOLICY_LLF.  It can be chosen without editing this file
+ * with "make clean; make POLICY=RM".  Under RM and DM admission control adds
+ * response time analysis to the EDF test. */
+#ifndef configEDF_SCHEDULING_POLICY
+	#define configEDF_SCHEDULING_POLICY			edfPOLICY_EDF
+#endif
+
+#endif /* configUSE_EDF_SCHEDULER */
+
 /*-----------------------------------------------------------
  * Application specific definitions.
  *
@@ -21,13 +67,16 @@
 
 #define configUSE_PREEMPTION					1
 #define configUSE_IDLE_HOOK						1
+#define configUSE_TICKLESS_IDLE					1	/* Stop the tick timer while every task is blocked. */
 #define configUSE_TICK_HOOK						0
+#define configUSE_DEADLINE_MISS_HOOK			1
 #define configTICK_RATE_HZ						( ( portTickType ) 1000 )
 #define configMINIMAL_STACK_SIZE				( ( unsigned portSHORT ) 64 ) /* This can be made smaller if required. */
 #define configTOTAL_HEAP_SIZE					( ( size_t ) ( 64 * 1024 ) )
 #define configMAX_TASK_NAME_LEN					( 16 )
 #define configUSE_TRACE_FACILITY				0
 #define configUSE_16_BIT_TICKS					0
+#define configUSE_64_BIT_TICKS					1	/* Required by the EDF scheduler, whose deadlines and wake times must never wrap. */
 #define configIDLE_SHOULD_YIELD					1
 #define configUSE_MUTEXES						1
 #define configCHECK_FOR_STACK_OVERFLOW			0 /* Do not use this option on the PC port. */
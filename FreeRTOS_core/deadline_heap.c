@@ -0,0 +1,236 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#include <stdlib.h>
+#include "FreeRTOS.h"
+#include "deadline_heap.h"
+
+/*
+ * Link two detached sub-heaps together and return the new root.  The root
+ * with the higher value becomes the first child of the other.  When the
+ * values are equal pxFirst stays on top.
+ */
+static DeadlineHeapItem_t *prvMeld( DeadlineHeapItem_t *pxFirst, DeadlineHeapItem_t *pxSecond ) PRIVILEGED_FUNCTION;
+
+/*
+ * Combine a list of siblings into a single sub-heap using the standard two
+ * pass pairing: meld the siblings in pairs from left to right, then meld the
+ * pairs from right to left.  Returns NULL if pxFirstSibling is NULL.
+ */
+static DeadlineHeapItem_t *prvCombineSiblings( DeadlineHeapItem_t *pxFirstSibling ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+ * PUBLIC DEADLINE HEAP API documented in deadline_heap.h
+ *----------------------------------------------------------*/
+
+void vDeadlineHeapInitialise( DeadlineHeap_t * const pxHeap )
+{
+	pxHeap->pxRoot = NULL;
+	pxHeap->uxNumberOfItems = ( UBaseType_t ) 0U;
+}
+/*-----------------------------------------------------------*/
+
+void vDeadlineHeapInitialiseItem( DeadlineHeapItem_t * const pxItem )
+{
+	/* Make sure the heap item is not recorded as being in a heap. */
+	pxItem->pvContainer = NULL;
+	pxItem->pxChild = NULL;
+	pxItem->pxNext = NULL;
+	pxItem->pxPrevious = NULL;
+}
+/*-----------------------------------------------------------*/
+
+void vDeadlineHeapInsert( DeadlineHeap_t * const pxHeap, DeadlineHeapItem_t * const pxNewHeapItem )
+{
+	configASSERT( pxNewHeapItem->pvContainer == NULL );
+
+	pxNewHeapItem->pxChild = NULL;
+	pxNewHeapItem->pxNext = NULL;
+	pxNewHeapItem->pxPrevious = NULL;
+
+	if( pxHeap->pxRoot == NULL )
+	{
+		pxHeap->pxRoot = pxNewHeapItem;
+	}
+	else
+	{
+		/* The existing root is passed first so it is not displaced by an item
+		of equal value. */
+		pxHeap->pxRoot = prvMeld( pxHeap->pxRoot, pxNewHeapItem );
+	}
+
+	/* Remember which heap the item is in.  This allows fast removal of the
+	item later. */
+	pxNewHeapItem->pvContainer = ( void * ) pxHeap;
+
+	( pxHeap->uxNumberOfItems )++;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxDeadlineHeapRemove( DeadlineHeapItem_t * const pxItemToRemove )
+{
+/* The heap item knows which heap it is in.  Obtain the heap from the heap
+item. */
+DeadlineHeap_t * const pxHeap = ( DeadlineHeap_t * ) pxItemToRemove->pvContainer;
+DeadlineHeapItem_t *pxSubHeap;
+
+	configASSERT( pxHeap );
+
+	pxSubHeap = prvCombineSiblings( pxItemToRemove->pxChild );
+
+	if( pxHeap->pxRoot == pxItemToRemove )
+	{
+		pxHeap->pxRoot = pxSubHeap;
+	}
+	else
+	{
+		/* Unlink the item from its parent or from its previous sibling. */
+		if( pxItemToRemove->pxPrevious->pxChild == pxItemToRemove )
+		{
+			pxItemToRemove->pxPrevious->pxChild = pxItemToRemove->pxNext;
+		}
+		else
+		{
+			pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
+		}
+
+		if( pxItemToRemove->pxNext != NULL )
+		{
+			pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* The children of the removed item cannot have a lower value than
+		the root, so the root is retained. */
+		if( pxSubHeap != NULL )
+		{
+			pxHeap->pxRoot = prvMeld( pxHeap->pxRoot, pxSubHeap );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	pxItemToRemove->pxChild = NULL;
+	pxItemToRemove->pxNext = NULL;
+	pxItemToRemove->pxPrevious = NULL;
+	pxItemToRemove->pvContainer = NULL;
+	( pxHeap->uxNumberOfItems )--;
+
+	return pxHeap->uxNumberOfItems;
+}
+/*-----------------------------------------------------------*/
+
+static DeadlineHeapItem_t *prvMeld( DeadlineHeapItem_t *pxFirst, DeadlineHeapItem_t *pxSecond )
+{
+DeadlineHeapItem_t *pxTemp;
+
+	if( pxSecond->xItemValue < pxFirst->xItemValue )
+	{
+		pxTemp = pxFirst;
+		pxFirst = pxSecond;
+		pxSecond = pxTemp;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* pxSecond becomes the first child of pxFirst. */
+	pxSecond->pxPrevious = pxFirst;
+	pxSecond->pxNext = pxFirst->pxChild;
+
+	if( pxFirst->pxChild != NULL )
+	{
+		pxFirst->pxChild->pxPrevious = pxSecond;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxFirst->pxChild = pxSecond;
+	pxFirst->pxNext = NULL;
+	pxFirst->pxPrevious = NULL;
+
+	return pxFirst;
+}
+/*-----------------------------------------------------------*/
+
+static DeadlineHeapItem_t *prvCombineSiblings( DeadlineHeapItem_t *pxFirstSibling )
+{
+DeadlineHeapItem_t *pxPairs = NULL, *pxFirst, *pxSecond, *pxNextPair;
+
+	if( pxFirstSibling == NULL )
+	{
+		return NULL;
+	}
+
+	/* First pass - meld the siblings in pairs from left to right.  The melded
+	pairs are chained through pxPrevious in reverse order, which is the order
+	the second pass needs them in. */
+	while( pxFirstSibling != NULL )
+	{
+		pxFirst = pxFirstSibling;
+		pxSecond = pxFirst->pxNext;
+
+		if( pxSecond != NULL )
+		{
+			pxFirstSibling = pxSecond->pxNext;
+			pxFirst = prvMeld( pxFirst, pxSecond );
+		}
+		else
+		{
+			pxFirstSibling = NULL;
+		}
+
+		pxFirst->pxPrevious = pxPairs;
+		pxPairs = pxFirst;
+	}
+
+	/* Second pass - meld the pairs from right to left. */
+	pxFirst = pxPairs;
+	pxPairs = pxPairs->pxPrevious;
+
+	while( pxPairs != NULL )
+	{
+		pxNextPair = pxPairs->pxPrevious;
+		pxFirst = prvMeld( pxFirst, pxPairs );
+		pxPairs = pxNextPair;
+	}
+
+	pxFirst->pxNext = NULL;
+	pxFirst->pxPrevious = NULL;
+
+	return pxFirst;
+}
+/*-----------------------------------------------------------*/
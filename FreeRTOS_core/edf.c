@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define STACK_PER_TASK 10
 #define MIN_STACK_PER_TASK 3
@@ -11,30 +12,31 @@ typedef struct _task
 	int e;		/* Worst case execution time */
 	int p;		/* Period of the task */
 	int d;		/* Deadline of the task */
+	int q;		/* Non-preemptive region, see vTaskSetNonPreemptiveRegion_EDF() */
 } task;
 
 /* Define the task set based on the contents of file t3 */
 task taskSet1[] = {
-	{1, 0, 1, 3, 3},
-	{2, 0, 4, 6, 6},
+	{1, 0, 1, 3, 3, 0},
+	{2, 0, 4, 6, 6, 0},
 };
 
 task taskSet2[] = {
-	{1, 0, 3, 20, 7},
-	{2, 0, 2, 5, 4},
-	{3, 0, 2, 10, 8},
+	{1, 0, 3, 20, 7, 0},
+	{2, 0, 2, 5, 4, 0},
+	{3, 0, 2, 10, 8, 0},
 };
 
 task taskSet3[] = {
-	{1, 0, 4, 12, 12},
-	{2, 0, 3, 9, 9},
-	{3, 0, 2, 6, 6},
+	{1, 0, 4, 12, 12, 0},
+	{2, 0, 3, 9, 9, 0},
+	{3, 0, 2, 6, 6, 0},
 };
 
 task taskSet4[] = {
-	{1, 0, 4, 12, 12},
-	{2, 0, 3, 9, 9},
-	{3, 0, 3, 6, 6},
+	{1, 0, 4, 12, 12, 0},
+	{2, 0, 3, 9, 9, 0},
+	{3, 0, 3, 6, 6, 0},
 };
 
 typedef struct _readyNode
@@ -51,6 +53,10 @@ void initializeQueue(readyNode **readyQueue, int numHyperperiod);
 int updateQueue(task *vTaskSet, readyNode **readyQueue, int readyLength, int t, int numTask);
 void edfSchedule(task *vTaskSet, readyNode **readyQueue, int numTask, int numHyperperiod);
 float calculateUtilizationCPU(task *vTaskSet, int numTask);
+int demandBound(task *vTaskSet, int numTask, int t);
+int blockingBound(task *vTaskSet, int numTask, int t);
+int checkLimitedPreemption(task *vTaskSet, int numTask, int horizon);
+void printMaxRegions(task *vTaskSet, int numTask, int horizon);
 
 /* Calculate the hyperperiod of a given task set */
 int calculateHyperperiod(task *vTaskSet, int numTask)
@@ -169,12 +175,82 @@ float calculateUtilizationCPU(task *vTaskSet, int numTask) {
     return utilization;
 }
 
-int main()
+/* Processor demand of the jobs with both release and deadline in [0, t] */
+int demandBound(task *vTaskSet, int numTask, int t)
+{
+	int demand = 0;
+
+	for (int i = 0; i < numTask; i++) {
+		if (t >= vTaskSet[i].d)
+			demand += ((t - vTaskSet[i].d) / vTaskSet[i].p + 1) * vTaskSet[i].e;
+	}
+	return demand;
+}
+
+/* Longest non-preemptive region of a task whose jobs cannot have a deadline
+ * in [0, t], so can delay the jobs that do */
+int blockingBound(task *vTaskSet, int numTask, int t)
+{
+	int blocking = 0;
+
+	for (int i = 0; i < numTask; i++) {
+		if (vTaskSet[i].d > t && vTaskSet[i].q > blocking)
+			blocking = vTaskSet[i].q;
+	}
+	return blocking;
+}
+
+/* Limited-preemption EDF is schedulable if, at every absolute deadline t, the
+ * demand plus the blocking by one longer deadline task fits in t */
+int checkLimitedPreemption(task *vTaskSet, int numTask, int horizon)
+{
+	int schedulable = 1;
+
+	for (int i = 0; i < numTask; i++) {
+		for (int t = vTaskSet[i].d; t <= horizon; t += vTaskSet[i].p) {
+			int demand = demandBound(vTaskSet, numTask, t);
+			int blocking = blockingBound(vTaskSet, numTask, t);
+
+			if (demand + blocking > t) {
+				printf("Deadline %d: demand %d + blocking %d exceeds it\n", t, demand, blocking);
+				schedulable = 0;
+			}
+		}
+	}
+	return schedulable;
+}
+
+/* The largest region a task can have is the least slack at any deadline
+ * shorter than its own, as those are the jobs it can delay */
+void printMaxRegions(task *vTaskSet, int numTask, int horizon)
+{
+	for (int k = 0; k < numTask; k++) {
+		int maxRegion = vTaskSet[k].e;
+
+		for (int i = 0; i < numTask; i++) {
+			for (int t = vTaskSet[i].d; t < vTaskSet[k].d && t <= horizon; t += vTaskSet[i].p) {
+				int slack = t - demandBound(vTaskSet, numTask, t);
+
+				if (slack < maxRegion)
+					maxRegion = slack;
+			}
+		}
+		if (maxRegion < 0)
+			maxRegion = 0;
+		printf("Task %d: region %d | largest schedulable region %d\n", vTaskSet[k].id, vTaskSet[k].q, maxRegion);
+	}
+}
+
+int main(int argc, char *argv[])
 {
 	/* Choose the task set */
 	task *currentTaskSet = taskSet4;
 	int numTask = sizeof(taskSet4) / sizeof(task);
 
+	/* "edf -npr" checks the task set under limited-preemption EDF instead of
+	 * printing its schedule */
+	int limitedPreemption = (argc > 1 && strcmp(argv[1], "-npr") == 0);
+
 	/* Check EDF schedulability */
 	float utilization = calculateUtilizationCPU(currentTaskSet, numTask);
 	printf("CPU Utilization = %.2f\n", utilization);
@@ -190,6 +266,23 @@ int main()
 
 	printf("Hyperperiod: %d\n", numHyperperiod);
 
+	if (limitedPreemption) {
+		/* With U <= 1 the demand pattern repeats every hyperperiod, so the
+		 * deadlines up to one hyperperiod plus the longest deadline cover it */
+		int horizon = numHyperperiod;
+
+		for (int i = 0; i < numTask; i++) {
+			if (numHyperperiod + currentTaskSet[i].d > horizon)
+				horizon = numHyperperiod + currentTaskSet[i].d;
+		}
+		printMaxRegions(currentTaskSet, numTask, horizon);
+		if (checkLimitedPreemption(currentTaskSet, numTask, horizon))
+			printf("Taskset is schedulable by limited-preemption EDF\n");
+		else
+			printf("Taskset is NOT schedulable by limited-preemption EDF\n");
+		return 0;
+	}
+
 	/* Initialize the ready queue */
 	readyNode *readyQueue;
 
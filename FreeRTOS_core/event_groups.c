@@ -53,6 +53,11 @@ taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
 	#define eventUNBLOCKED_DUE_TO_BIT_SET	0x0200U
 	#define eventWAIT_FOR_ALL_BITS			0x0400U
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff00U
+#elif configUSE_64_BIT_TICKS == 1
+	#define eventCLEAR_EVENTS_ON_EXIT_BIT	0x0100000000000000ULL
+	#define eventUNBLOCKED_DUE_TO_BIT_SET	0x0200000000000000ULL
+	#define eventWAIT_FOR_ALL_BITS			0x0400000000000000ULL
+	#define eventEVENT_BITS_CONTROL_BYTES	0xff00000000000000ULL
 #else
 	#define eventCLEAR_EVENTS_ON_EXIT_BIT	0x01000000UL
 	#define eventUNBLOCKED_DUE_TO_BIT_SET	0x02000000UL
@@ -104,6 +104,14 @@ extern "C" {
 	#error Missing definition:  configUSE_16_BIT_TICKS must be defined in FreeRTOSConfig.h as either 1 or 0.  See the Configuration section of the FreeRTOS API documentation for details.
 #endif
 
+#ifndef configUSE_64_BIT_TICKS
+	#define configUSE_64_BIT_TICKS 0
+#endif
+
+#if( ( configUSE_16_BIT_TICKS == 1 ) && ( configUSE_64_BIT_TICKS == 1 ) )
+	#error configUSE_16_BIT_TICKS and configUSE_64_BIT_TICKS cannot both be set to 1.
+#endif
+
 #ifndef configUSE_CO_ROUTINES
 	#define configUSE_CO_ROUTINES 0
 #endif
@@ -186,6 +194,54 @@ extern "C" {
 	#define configUSE_DAEMON_TASK_STARTUP_HOOK 0
 #endif
 
+#ifndef configUSE_DEADLINE_MISS_HOOK
+	#define configUSE_DEADLINE_MISS_HOOK 0
+#endif
+
+#ifndef configUSE_BUDGET_OVERRUN_HOOK
+	#define configUSE_BUDGET_OVERRUN_HOOK 0
+#endif
+
+#ifndef configUSE_SRP_MUTEXES
+	#define configUSE_SRP_MUTEXES 0
+#endif
+
+/* The scheduling policies that configEDF_SCHEDULING_POLICY can select when
+configUSE_EDF_SCHEDULER is 1.  Every policy orders the ready tasks by a single
+value, so each has the same overhead as EDF itself. */
+#define edfPOLICY_EDF	0	/* Earliest absolute deadline first. */
+#define edfPOLICY_RM	1	/* Rate monotonic - shortest period first. */
+#define edfPOLICY_DM	2	/* Deadline monotonic - shortest relative deadline first. */
+#define edfPOLICY_LLF	3	/* Least laxity first - least slack to the deadline after the rest of the WCET. */
+
+#ifndef configEDF_SCHEDULING_POLICY
+	#define configEDF_SCHEDULING_POLICY edfPOLICY_EDF
+#endif
+
+#ifndef configUSE_EDF_PRIORITY_BANDS
+	#define configUSE_EDF_PRIORITY_BANDS 0
+#endif
+
+#ifndef configUSE_EDF_LIMITED_PREEMPTION
+	#define configUSE_EDF_LIMITED_PREEMPTION 0
+#endif
+
+#ifndef configUSE_EDF_ELASTIC_TASKS
+	#define configUSE_EDF_ELASTIC_TASKS 0
+#endif
+
+#ifndef configEDF_ELASTIC_UTILISATION
+	#define configEDF_ELASTIC_UTILISATION 100
+#endif
+
+#ifndef configUSE_EDF_MK_FIRM
+	#define configUSE_EDF_MK_FIRM 0
+#endif
+
+#ifndef configUSE_EDF_ADMISSION_CONTROL
+	#define configUSE_EDF_ADMISSION_CONTROL 0
+#endif
+
 #ifndef configUSE_APPLICATION_TASK_TAG
 	#define configUSE_APPLICATION_TASK_TAG 0
 #endif
@@ -520,6 +576,14 @@ extern "C" {
 	#define traceTASK_RESUME_FROM_ISR( pxTaskToResume )
 #endif
 
+#ifndef traceTASK_RELEASE_JOB_FROM_ISR
+	#define traceTASK_RELEASE_JOB_FROM_ISR( pxTask )
+#endif
+
+#ifndef traceTASK_SKIP_JOB
+	#define traceTASK_SKIP_JOB( pxTask )
+#endif
+
 #ifndef traceTASK_INCREMENT_TICK
 	#define traceTASK_INCREMENT_TICK( xTickCount )
 #endif
@@ -841,6 +905,16 @@ extern "C" {
 	#error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if( ( configUSE_SRP_MUTEXES == 1 ) && ( ( configUSE_MUTEXES != 1 ) || ( configUSE_EDF_SCHEDULER != 1 ) ) )
+	#error configUSE_MUTEXES and configUSE_EDF_SCHEDULER must be set to 1 to use SRP mutexes
+#endif
+
+/* The EDF scheduler compares absolute deadlines, release times and scheduling
+keys directly, which is only correct while the tick count cannot wrap. */
+#if( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_64_BIT_TICKS != 1 ) )
+	#error configUSE_64_BIT_TICKS must be set to 1 to use the EDF scheduler
+#endif
+
 #ifndef configINITIAL_TICK_COUNT
 	#define configINITIAL_TICK_COUNT 0
 #endif
@@ -1070,6 +1144,10 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy9;
 	#endif
 
+	#if ( configUSE_SRP_MUTEXES == 1 )
+		TickType_t xDummy10[ 2 ];
+	#endif
+
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -0,0 +1,179 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * This is the priority queue used by the EDF scheduler to hold ready tasks in
+ * absolute deadline order.  Like the list implementation it is intrusive: the
+ * heap never allocates memory, each DeadlineHeapItem_t lives inside the object
+ * (normally a TCB) that owns it.
+ *
+ * The heap is a pairing heap.  Each item holds a pointer to its first child,
+ * to its next sibling and to its previous sibling (or to its parent if it is
+ * the first child).  The item with the lowest xItemValue is always the root, so
+ * it can be read in O(1).  Inserting an item is O(1) and removing any item,
+ * including the root, is O(log n) amortised.  Items with equal values are not
+ * reordered on insertion, so an item inserted with the same value as the root
+ * does not displace it.
+ *
+ * Like list items, each heap item holds a pointer back to the heap it is in
+ * (pvContainer) and to the object that owns it (pvOwner).
+ *
+ * \page DeadlineHeapIntroduction Deadline Heap Implementation
+ * \ingroup FreeRTOSIntro
+ */
+
+#ifndef INC_FREERTOS_H
+	#error FreeRTOS.h must be included before deadline_heap.h
+#endif
+
+#ifndef DEADLINE_HEAP_H
+#define DEADLINE_HEAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Definition of the only type of object that a deadline heap can contain.
+ */
+struct xDEADLINE_HEAP_ITEM
+{
+	TickType_t xItemValue;								/*< The value the heap is ordered by.  The item with the lowest value is at the root. */
+	struct xDEADLINE_HEAP_ITEM * pxChild;				/*< Pointer to the first child of this item. */
+	struct xDEADLINE_HEAP_ITEM * pxNext;				/*< Pointer to the next sibling of this item. */
+	struct xDEADLINE_HEAP_ITEM * pxPrevious;			/*< Pointer to the previous sibling of this item, or to its parent if this is the first child. */
+	void * pvOwner;										/*< Pointer to the object (normally a TCB) that contains the heap item. */
+	void * volatile pvContainer;						/*< Pointer to the heap in which this item is placed (if any). */
+};
+typedef struct xDEADLINE_HEAP_ITEM DeadlineHeapItem_t;
+
+/*
+ * Definition of the deadline heap used by the scheduler.
+ */
+typedef struct xDEADLINE_HEAP
+{
+	volatile UBaseType_t uxNumberOfItems;
+	DeadlineHeapItem_t * pxRoot;						/*< The item with the lowest value, or NULL if the heap is empty. */
+} DeadlineHeap_t;
+
+/*
+ * Access macro to set the owner of a heap item.  The owner of a heap item
+ * is the object (usually a TCB) that contains the heap item.
+ */
+#define heapSET_HEAP_ITEM_OWNER( pxHeapItem, pxOwner )		( ( pxHeapItem )->pvOwner = ( void * ) ( pxOwner ) )
+
+/*
+ * Access macro to get the owner of a heap item.
+ */
+#define heapGET_HEAP_ITEM_OWNER( pxHeapItem )	( ( pxHeapItem )->pvOwner )
+
+/*
+ * Access macro to set the value of a heap item.  The value must not be changed
+ * while the item is in a heap - remove it, change the value, then insert it
+ * again.
+ */
+#define heapSET_HEAP_ITEM_VALUE( pxHeapItem, xValue )	( ( pxHeapItem )->xItemValue = ( xValue ) )
+
+/*
+ * Access macro to retrieve the value of a heap item.
+ */
+#define heapGET_HEAP_ITEM_VALUE( pxHeapItem )	( ( pxHeapItem )->xItemValue )
+
+/*
+ * Access macro to determine if a heap contains any items.  The macro will
+ * only have the value true if the heap is empty.
+ */
+#define heapHEAP_IS_EMPTY( pxHeap )	( ( BaseType_t ) ( ( pxHeap )->uxNumberOfItems == ( UBaseType_t ) 0 ) )
+
+/*
+ * Access macro to return the number of items in the heap.
+ */
+#define heapCURRENT_HEAP_LENGTH( pxHeap )	( ( pxHeap )->uxNumberOfItems )
+
+/*
+ * Access macro to obtain the owner of the item with the lowest value.  The
+ * heap must not be empty.
+ */
+#define heapGET_OWNER_OF_HEAD_ITEM( pxHeap )	( ( pxHeap )->pxRoot->pvOwner )
+
+/*
+ * Access macro to obtain the lowest value held in the heap.  The heap must not
+ * be empty.
+ */
+#define heapGET_ITEM_VALUE_OF_HEAD_ITEM( pxHeap )	( ( pxHeap )->pxRoot->xItemValue )
+
+/*
+ * Check to see if a heap item is within a heap.
+ */
+#define heapIS_CONTAINED_WITHIN( pxHeap, pxHeapItem ) ( ( BaseType_t ) ( ( pxHeapItem )->pvContainer == ( void * ) ( pxHeap ) ) )
+
+/*
+ * Return the heap a heap item is contained within, or NULL.
+ */
+#define heapHEAP_ITEM_CONTAINER( pxHeapItem ) ( ( pxHeapItem )->pvContainer )
+
+/*
+ * Must be called before a heap is used.
+ *
+ * @param pxHeap Pointer to the heap being initialised.
+ */
+void vDeadlineHeapInitialise( DeadlineHeap_t * const pxHeap ) PRIVILEGED_FUNCTION;
+
+/*
+ * Must be called before a heap item is used.  This sets the heap container to
+ * null so the item does not think that it is already contained in a heap.
+ *
+ * @param pxItem Pointer to the heap item being initialised.
+ */
+void vDeadlineHeapInitialiseItem( DeadlineHeapItem_t * const pxItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert a heap item into a heap, ordered by its item value.  O(1).
+ *
+ * @param pxHeap The heap into which the item is to be inserted.
+ *
+ * @param pxNewHeapItem The item that is to be placed in the heap.
+ */
+void vDeadlineHeapInsert( DeadlineHeap_t * const pxHeap, DeadlineHeapItem_t * const pxNewHeapItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove an item from a heap.  The heap item has a pointer to the heap that
+ * it is in, so only the heap item need be passed into the function.  The item
+ * need not be the root.  O(log n) amortised.
+ *
+ * @param pxItemToRemove The item to be removed.
+ *
+ * @return The number of items that remain in the heap after the item has been
+ * removed.
+ */
+UBaseType_t uxDeadlineHeapRemove( DeadlineHeapItem_t * const pxItemToRemove ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
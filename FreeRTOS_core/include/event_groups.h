@@ -83,7 +83,7 @@ typedef void * EventGroupHandle_t;
 /*
  * The type that holds event bits always matches TickType_t - therefore the
  * number of bits it holds is set by configUSE_16_BIT_TICKS (16 bits if set to 1,
- * 32 bits if set to 0.
+ * 32 bits if set to 0) and configUSE_64_BIT_TICKS (64 bits if set to 1).
  *
  * \defgroup EventBits_t EventBits_t
  * \ingroup EventGroup
@@ -113,8 +113,9 @@ typedef TickType_t EventBits_t;
  * on the configUSE_16_BIT_TICKS setting in FreeRTOSConfig.h.  If
  * configUSE_16_BIT_TICKS is 1 then each event group contains 8 usable bits (bit
  * 0 to bit 7).  If configUSE_16_BIT_TICKS is set to 0 then each event group has
- * 24 usable bits (bit 0 to bit 23).  The EventBits_t type is used to store
- * event bits within an event group.
+ * 24 usable bits (bit 0 to bit 23), or 56 usable bits (bit 0 to bit 55) if
+ * configUSE_64_BIT_TICKS is 1.  The EventBits_t type is used to store event
+ * bits within an event group.
  *
  * @return If the event group was created then a handle to the event group is
  * returned.  If there was insufficient FreeRTOS heap available to create the
@@ -169,8 +170,9 @@ typedef TickType_t EventBits_t;
  * on the configUSE_16_BIT_TICKS setting in FreeRTOSConfig.h.  If
  * configUSE_16_BIT_TICKS is 1 then each event group contains 8 usable bits (bit
  * 0 to bit 7).  If configUSE_16_BIT_TICKS is set to 0 then each event group has
- * 24 usable bits (bit 0 to bit 23).  The EventBits_t type is used to store
- * event bits within an event group.
+ * 24 usable bits (bit 0 to bit 23), or 56 usable bits (bit 0 to bit 55) if
+ * configUSE_64_BIT_TICKS is 1.  The EventBits_t type is used to store event
+ * bits within an event group.
  *
  * @param pxEventGroupBuffer pxEventGroupBuffer must point to a variable of type
  * StaticEventGroup_t, which will be then be used to hold the event group's data
@@ -388,6 +388,24 @@ void vListInsert( List_t * const pxList, ListItem_t * const pxNewListItem ) PRIV
  */
 void vListInsertEnd( List_t * const pxList, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
 
+/*
+ * Insert a list item into a list directly after another item.  Used where the
+ * position of the item is chosen by a comparison that its item value alone
+ * cannot express.  The item value of the new item is not changed.
+ *
+ * @param pxList The list into which the item is to be inserted.
+ *
+ * @param pxPosition The item, already in pxList, that the new item is to
+ * follow, or the end marker of pxList to make the new item the head of the
+ * list.
+ *
+ * @param pxNewListItem The list item to be inserted into the list.
+ *
+ * \page vListInsertAfter vListInsertAfter
+ * \ingroup LinkedList
+ */
+void vListInsertAfter( List_t * const pxList, ListItem_t * const pxPosition, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+
 /*
  * Remove an item from a list.  The list item has a pointer to the list that
  * it is in, so only the list item need be passed into the function.
@@ -53,6 +53,7 @@ definition here is not suitable for your application. */
 #define errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY	( -1 )
 #define errQUEUE_BLOCKED						( -4 )
 #define errQUEUE_YIELD							( -5 )
+#define errTASK_NOT_SCHEDULABLE					( -6 )
 
 /* Macros used for basic data corruption checks. */
 #ifndef configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES
@@ -61,6 +62,8 @@ definition here is not suitable for your application. */
 
 #if( configUSE_16_BIT_TICKS == 1 )
 	#define pdINTEGRITY_CHECK_VALUE 0x5a5a
+#elif( configUSE_64_BIT_TICKS == 1 )
+	#define pdINTEGRITY_CHECK_VALUE 0x5a5a5a5a5a5a5a5aULL
 #else
 	#define pdINTEGRITY_CHECK_VALUE 0x5a5a5a5aUL
 #endif
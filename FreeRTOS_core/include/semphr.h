@@ -716,6 +716,62 @@ typedef QueueHandle_t SemaphoreHandle_t;
 	#define xSemaphoreCreateMutex() xQueueCreateMutex( queueQUEUE_TYPE_MUTEX )
 #endif
 
+/**
+ * semphr. h
+ * <pre>SemaphoreHandle_t xSemaphoreCreateMutexSRP( TickType_t xCeiling )</pre>
+ *
+ * Creates a mutex that is managed by the Stack Resource Policy (SRP) when the
+ * EDF scheduler is used.  configUSE_SRP_MUTEXES must be set to 1 in
+ * FreeRTOSConfig.h for this macro to be available.
+ *
+ * Priority inheritance has no effect under EDF, as every EDF task has the same
+ * priority.  Instead, each EDF task has a preemption level given by its
+ * relative deadline - the shorter the deadline the higher the level - and each
+ * SRP mutex has a ceiling equal to the shortest relative deadline of any task
+ * that takes it.  While SRP mutexes are held, a job whose relative deadline is
+ * not shorter than the shortest of their ceilings is not allowed to start, even
+ * if it has the earliest deadline.  A job is therefore blocked at most once,
+ * before it starts, by at most one job of a task with a longer deadline, and
+ * never has to wait inside xSemaphoreTake().
+ *
+ * SRP mutexes are taken and given with xSemaphoreTake() and xSemaphoreGive().
+ * They cannot be used recursively.  When more than one SRP mutex is held they
+ * must be given back in the reverse order to that in which they were taken, and
+ * a task must not block while it holds an SRP mutex.
+ *
+ * @param xCeiling The shortest relative deadline, in ticks, of any task that
+ * will take the mutex.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  If there was not enough heap to allocate the mutex data
+ * structures then NULL is returned.
+ *
+ * Example usage:
+ <pre>
+ // Both tasks take xResource, and vTaskA has the shorter relative deadline.
+ xResource = xSemaphoreCreateMutexSRP( TASK_A_DEADLINE );
+
+ void vTaskB( void * pvParameters )
+ {
+    for( ;; )
+    {
+        // While vTaskB holds xResource, vTaskA cannot start a new job, so
+        // xSemaphoreTake() never blocks in either task.
+        xSemaphoreTake( xResource, portMAX_DELAY );
+        // Access the shared resource here.
+        xSemaphoreGive( xResource );
+
+        vTaskWaitForNextJob_EDF();
+    }
+ }
+ </pre>
+ * \defgroup xSemaphoreCreateMutexSRP xSemaphoreCreateMutexSRP
+ * \ingroup Semaphores
+ */
+#if( ( configUSE_SRP_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+	#define xSemaphoreCreateMutexSRP( xCeiling ) xQueueCreateMutexSRP( ( xCeiling ) )
+#endif
+
 /**
  * semphr. h
  * <pre>SemaphoreHandle_t xSemaphoreCreateMutexStatic( StaticSemaphore_t *pxMutexBuffer )</pre>
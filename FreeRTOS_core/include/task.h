@@ -87,6 +87,15 @@ typedef enum
 	eSetValueWithoutOverwrite	/* Set the task's notification value if the previous value has been read by the task. */
 } eNotifyAction;
 
+/* Actions that can be taken when a job of an EDF task runs for longer than the
+WCET given to xTaskCreate_EDF().  See vTaskSetOverrunAction_EDF(). */
+typedef enum
+{
+	eOverrunNotify = 0,		/* Count the overrun and call vApplicationBudgetOverrunHook(), if configured, but let the job carry on as before. */
+	eOverrunDemote,			/* As eOverrunNotify, then demote the rest of the job to the background, so it only runs when no job with a deadline is ready. */
+	eOverrunAbort			/* As eOverrunNotify, then abandon the job.  The rest of it runs in the background, and the task's next call to vTaskWaitForNextJob_EDF() waits for the job after it. */
+} eBudgetOverrunAction;
+
 /*
  * Used internally only.
  */
@@ -138,6 +147,23 @@ typedef struct xTASK_STATUS
 	uint16_t usStackHighWaterMark;	/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* Used with the vTaskGetJobStatus_EDF() function to return the job that an EDF
+task is currently executing, or most recently executed. */
+typedef struct xTASK_JOB_STATUS
+{
+	UBaseType_t uxJobNumber;		/* The number of jobs released so far.  The first job released when the task is created is job 1. */
+	TickType_t xRelease;			/* The tick at which the job was released. */
+	TickType_t xDeadline;			/* The absolute deadline of the job - the release time plus the relative deadline of the task. */
+	UBaseType_t uxDeadlineMisses;	/* The number of jobs of the task that have missed their deadline. */
+	TickType_t xMaxLateness;		/* The largest number of ticks by which a job of the task completed after its deadline. */
+	TickType_t xTotalTardiness;		/* The total number of ticks by which jobs of the task completed after their deadlines. */
+	TickType_t xExecutionTime;		/* The number of ticks the job has executed for so far. */
+	TickType_t xMaxExecutionTime;	/* The longest execution time, in ticks, of any completed job of the task. */
+	UBaseType_t uxBudgetOverruns;	/* The number of jobs of the task that executed for longer than its WCET. */
+	TickType_t xPeriod;				/* The period the task is currently released with, which differs from its nominal period while an elastic task is stretched. */
+	UBaseType_t uxSkippedJobs;		/* The number of jobs of the task skipped to keep it within its (m,k)-firm constraint.  Skipped jobs are not counted in uxDeadlineMisses. */
+} TaskJobStatus_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -326,6 +352,24 @@ is used in assert() statements. */
 							TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
 #endif
 
+/*
+ * Create a periodic task scheduled by earliest deadline first.  Parameters are
+ * as xTaskCreate(), plus the period of the task, the deadline of each job
+ * relative to its release and the worst case execution time (WCET) of each
+ * job, all in ticks.  A deadline of zero means the deadline is equal to the
+ * period.
+ *
+ * If configUSE_EDF_ADMISSION_CONTROL is 1 the task is only created if the
+ * tasks already admitted, plus the new task, remain schedulable when every job
+ * runs for its WCET.  Otherwise errTASK_NOT_SCHEDULABLE is returned.  A task
+ * with a WCET of zero places no demand on the analysis and is always admitted.
+ *
+ * The first job is released when the task is created.  The task ends each job
+ * by calling vTaskWaitForNextJob_EDF().  The kernel releases the next job one
+ * period after the previous release, with an absolute deadline of the release
+ * time plus the relative deadline.  Tasks that call vTaskDelayUntil() instead
+ * have their next job released at the wake time.
+ */
 #if( configUSE_EDF_SCHEDULER == 1 )
     BaseType_t xTaskCreate_EDF(  TaskFunction_t pxTaskCode,
                                     const char * const pcName,
@@ -334,7 +378,66 @@ is used in assert() statements. */
                                     UBaseType_t uxPriority,
                                     TaskHandle_t * const pxCreatedTask,
                                     TickType_t period,
-                                    TickType_t deadline ) PRIVILEGED_FUNCTION;
+                                    TickType_t deadline,
+                                    TickType_t wcet ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Create a sporadic task scheduled by earliest deadline first, whose jobs are
+ * released by xTaskReleaseJobFromISR_EDF() rather than at fixed times.
+ * Parameters are as xTaskCreate_EDF() except that the period is replaced by the
+ * minimum inter-arrival time - the shortest time allowed between the releases
+ * of two jobs.  A deadline of zero means the deadline is equal to the minimum
+ * inter-arrival time.
+ *
+ * A sporadic task never places more demand on the processor than a periodic
+ * task with a period of the minimum inter-arrival time, so it is admitted as
+ * one if configUSE_EDF_ADMISSION_CONTROL is 1.
+ *
+ * The first job is released when the task is created, so the task can
+ * initialise itself.  The task ends each job by calling
+ * vTaskWaitForNextJob_EDF(), and must not use vTaskDelayUntil().
+ */
+#if( configUSE_EDF_SCHEDULER == 1 )
+    BaseType_t xTaskCreateSporadic_EDF(  TaskFunction_t pxTaskCode,
+                                    const char * const pcName,
+                                    const configSTACK_DEPTH_TYPE usStackDepth,
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    TaskHandle_t * const pxCreatedTask,
+                                    TickType_t interarrival,
+                                    TickType_t deadline,
+                                    TickType_t wcet ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Create a task served by a Constant Bandwidth Server (CBS), for soft real time
+ * or aperiodic work scheduled alongside the tasks created with
+ * xTaskCreate_EDF().  Parameters are as xTaskCreate(), plus the budget Q and
+ * the server period T of the server, both in ticks.
+ *
+ * The task is scheduled by a server deadline.  Each tick the task runs is
+ * charged to its budget, and when the budget is used up it is refilled and the
+ * server deadline postponed by T, so the task never receives more than a
+ * fraction Q / T of the processor while other tasks are waiting.  A task that
+ * wakes after blocking is given a new deadline one period later if its
+ * remaining budget could not otherwise be used within that bandwidth.  The
+ * task does not have jobs, so it blocks on queues, delays and so on as any
+ * other task and must not call vTaskWaitForNextJob_EDF().
+ *
+ * If configUSE_EDF_ADMISSION_CONTROL is 1 the server is admitted as a periodic
+ * task with C = Q and D = T, and errTASK_NOT_SCHEDULABLE is returned if it
+ * would make the EDF tasks unschedulable.
+ */
+#if( configUSE_EDF_SCHEDULER == 1 )
+    BaseType_t xTaskCreate_CBS(  TaskFunction_t pxTaskCode,
+                                    const char * const pcName,
+                                    const configSTACK_DEPTH_TYPE usStackDepth,
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    TaskHandle_t * const pxCreatedTask,
+                                    TickType_t budget,
+                                    TickType_t period ) PRIVILEGED_FUNCTION;
 #endif
 
 
@@ -819,6 +922,333 @@ void vTaskDelay( const TickType_t xTicksToDelay ) PRIVILEGED_FUNCTION;
  */
 void vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskWaitForNextJob_EDF( void );</pre>
+ *
+ * End the current job of the calling task and block until its next job is
+ * released.  The calling task must have been created with xTaskCreate_EDF().
+ *
+ * The kernel keeps the release time of each job, so unlike vTaskDelayUntil()
+ * the task does not need to track its own wake time.  The next job is released
+ * one period after the current one, by the tick interrupt that unblocks the
+ * task.  If the current job overran its period the next job is released
+ * immediately and the task does not block.  If the kernel abandoned the
+ * current job, see xTaskIsJobAborted_EDF(), the call ends that job without
+ * recording it as completed and waits for the job after it in the same way.
+ *
+ * A task created with xTaskCreateSporadic_EDF() blocks until the next arrival
+ * signalled by xTaskReleaseJobFromISR_EDF() releases its next job.
+ *
+ * Example usage:
+   <pre>
+ void vTaskFunction( void * pvParameters )
+ {
+	 for( ;; )
+	 {
+		 // Perform the work of one job here.
+
+		 vTaskWaitForNextJob_EDF();
+	 }
+ }
+   </pre>
+ * \defgroup vTaskWaitForNextJob_EDF vTaskWaitForNextJob_EDF
+ * \ingroup TaskCtrl
+ */
+#if( configUSE_EDF_SCHEDULER == 1 )
+	void vTaskWaitForNextJob_EDF( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>BaseType_t xTaskReleaseJobFromISR_EDF( TaskHandle_t xTask, BaseType_t *pxHigherPriorityTaskWoken );</pre>
+ *
+ * Signal the arrival of a job of a task created with xTaskCreateSporadic_EDF(),
+ * for example from the interrupt that delivers the data the job processes.
+ * The job is released at the time of the arrival, with an absolute deadline of
+ * the arrival time plus the relative deadline of the task.
+ *
+ * A job is only released once the previous job has completed and the minimum
+ * inter-arrival time has passed since the previous release.  An arrival that
+ * is too early is not rejected but deferred: it is held pending and its job is
+ * released, with its deadline measured from the release, as soon as both
+ * conditions are met.  Arrivals are released in order, one minimum inter-arrival
+ * time apart.
+ *
+ * @param xTask The handle of the sporadic task.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the released job preempts
+ * the task that was running when the interrupt occurred, in which case a
+ * context switch should be requested before the interrupt is exited.
+ *
+ * @return pdTRUE if the job was released immediately, or pdFALSE if the
+ * arrival was deferred.
+ *
+ * Example usage:
+   <pre>
+ void vSensorTask( void * pvParameters )
+ {
+	 for( ;; )
+	 {
+		 vTaskWaitForNextJob_EDF();
+
+		 // Process the frame that released this job.
+	 }
+ }
+
+ void vSensorISR( void )
+ {
+ BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	 xTaskReleaseJobFromISR_EDF( xSensorTask, &xHigherPriorityTaskWoken );
+	 portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ }
+   </pre>
+ * \defgroup xTaskReleaseJobFromISR_EDF xTaskReleaseJobFromISR_EDF
+ * \ingroup TaskCtrl
+ */
+#if( configUSE_EDF_SCHEDULER == 1 )
+	BaseType_t xTaskReleaseJobFromISR_EDF( TaskHandle_t xTask, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>void vTaskGetJobStatus_EDF( TaskHandle_t xTask, TaskJobStatus_t *pxJobStatus );</pre>
+ *
+ * Populates a TaskJobStatus_t structure with the release number, release time
+ * and absolute deadline of the current job of an EDF task, along with the
+ * deadline miss statistics of the task.
+ *
+ * A job misses its deadline if it has not completed by the end of the tick
+ * at its absolute deadline.  The miss is counted, and
+ * vApplicationDeadlineMissHook() called if configUSE_DEADLINE_MISS_HOOK is 1,
+ * from the tick interrupt at which it is detected.  The lateness of the job is
+ * added to the tardiness statistics when the job eventually completes.
+ *
+ * @param xTask The handle of the task being queried.  Passing NULL queries
+ * the calling task.
+ *
+ * @param pxJobStatus A pointer to the TaskJobStatus_t structure that will be
+ * filled with information about the job.
+ *
+ * \defgroup vTaskGetJobStatus_EDF vTaskGetJobStatus_EDF
+ * \ingroup TaskCtrl
+ */
+#if( configUSE_EDF_SCHEDULER == 1 )
+	void vTaskGetJobStatus_EDF( TaskHandle_t xTask, TaskJobStatus_t *pxJobStatus ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>void vTaskSetOverrunAction_EDF( TaskHandle_t xTask, eBudgetOverrunAction eAction );</pre>
+ *
+ * The kernel counts the ticks each job of an EDF task executes for.  Set what
+ * happens when a job executes for longer than the WCET passed to
+ * xTaskCreate_EDF().  The default is eOverrunNotify.  Tasks created with a
+ * WCET of zero are never considered to overrun.
+ *
+ * The kernel cannot unwind the stack of a task, so a job abandoned by
+ * eOverrunAbort is no longer tracked against its deadline and only runs when
+ * no job with a deadline is ready.  The task should poll
+ * xTaskIsJobAborted_EDF() at convenient points and call
+ * vTaskWaitForNextJob_EDF() as soon as it returns pdTRUE.  That call waits for
+ * the job after the abandoned one, so the rest of the abandoned job is never
+ * run in the time of the next job.
+ *
+ * @param xTask The handle of the task.  Passing NULL sets the action of the
+ * calling task.
+ *
+ * @param eAction One of eOverrunNotify, eOverrunDemote or eOverrunAbort.
+ *
+ * \defgroup vTaskSetOverrunAction_EDF vTaskSetOverrunAction_EDF
+ * \ingroup TaskCtrl
+ */
+#if( configUSE_EDF_SCHEDULER == 1 )
+	void vTaskSetOverrunAction_EDF( TaskHandle_t xTask, eBudgetOverrunAction eAction ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>BaseType_t xTaskIsJobAborted_EDF( void );</pre>
+ *
+ * Query whether the kernel has abandoned the current job of the calling EDF
+ * task, because it overran its WCET with the eOverrunAbort action set or was
+ * skipped under an (m,k)-firm constraint.  Once it has, the task should stop the work of the job and call
+ * vTaskWaitForNextJob_EDF().
+ *
+ * @return pdTRUE if the current job has been abandoned, otherwise pdFALSE.
+ *
+ * Example usage:
+   <pre>
+ void vTask( void *pvParameters )
+ {
+	 for( ;; )
+	 {
+		 for( x = 0; x < uxSteps; x++ )
+		 {
+			 if( xTaskIsJobAborted_EDF() != pdFALSE )
+			 {
+				 break;
+			 }
+
+			 vDoStep( x );
+		 }
+
+		 vTaskWaitForNextJob_EDF();
+	 }
+ }
+   </pre>
+ * \defgroup xTaskIsJobAborted_EDF xTaskIsJobAborted_EDF
+ * \ingroup TaskCtrl
+ */
+#if( configUSE_EDF_SCHEDULER == 1 )
+	BaseType_t xTaskIsJobAborted_EDF( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>void vTaskSetMKFirm_EDF( TaskHandle_t xTask, UBaseType_t uxM, UBaseType_t uxK );</pre>
+ *
+ * configUSE_EDF_MK_FIRM must be defined as 1 for this function to be
+ * available.
+ *
+ * Give an EDF task an (m,k)-firm constraint - at least uxM jobs of any uxK
+ * consecutive jobs must meet their deadline.  Under a transient overload EDF
+ * lets every job run late, so each late job delays the jobs behind it until
+ * every task misses.  The kernel instead skips a job of the task, as long as
+ * the constraint still holds, when:
+ *
+ * - the job is running and its remaining WCET cannot be executed by its
+ *   deadline, or
+ *
+ * - the job misses its deadline.
+ *
+ * A skipped job is abandoned as with eOverrunAbort, so its remaining budget is
+ * given to the other jobs - the rest of it runs only when no job with a
+ * deadline is ready, and xTaskIsJobAborted_EDF() returns pdTRUE until the task
+ * calls vTaskWaitForNextJob_EDF(), which waits for the job after the skipped
+ * one.  Skipped jobs are counted in
+ * uxSkippedJobs in TaskJobStatus_t, and do not call the deadline miss hook.  A
+ * job that misses its deadline when the constraint does not allow it to be
+ * skipped is treated as any other miss.
+ *
+ * @param xTask The handle of the task.  Passing NULL sets the constraint of
+ * the calling task.
+ *
+ * @param uxM The number of jobs in any uxK consecutive jobs that must meet
+ * their deadline.
+ *
+ * @param uxK The length of the window, at most 32.  0 removes the constraint,
+ * so the jobs of the task are never skipped.
+ *
+ * \defgroup vTaskSetMKFirm_EDF vTaskSetMKFirm_EDF
+ * \ingroup TaskCtrl
+ */
+#if( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_MK_FIRM == 1 ) )
+	void vTaskSetMKFirm_EDF( TaskHandle_t xTask, UBaseType_t uxM, UBaseType_t uxK ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>void vTaskSetNonPreemptiveRegion_EDF( TaskHandle_t xTask, TickType_t xRegion );</pre>
+ *
+ * configUSE_EDF_LIMITED_PREEMPTION must be defined as 1 for this function to
+ * be available.
+ *
+ * Give an EDF task a floating non-preemptive region.  When a job with an
+ * earlier deadline becomes ready while the task is running, the task keeps the
+ * processor for up to xRegion more ticks before it is preempted, so a job with
+ * only a slightly earlier deadline often does not cause a context switch at
+ * all.  A job with an earlier deadline can therefore be delayed by up to
+ * xRegion ticks, which must be accounted for when choosing xRegion - the edf
+ * tool prints the largest region each task of a task set can be given without
+ * any deadline being missed.
+ *
+ * The region only defers preemption.  The task still gives up the processor
+ * as normal if it blocks, for example by calling vTaskWaitForNextJob_EDF().
+ *
+ * @param xTask The handle of the task.  Passing NULL sets the region of the
+ * calling task.
+ *
+ * @param xRegion The length of the region in ticks.  0, the default, makes the
+ * task fully preemptive.
+ *
+ * \defgroup vTaskSetNonPreemptiveRegion_EDF vTaskSetNonPreemptiveRegion_EDF
+ * \ingroup TaskCtrl
+ */
+#if( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_LIMITED_PREEMPTION == 1 ) )
+	void vTaskSetNonPreemptiveRegion_EDF( TaskHandle_t xTask, TickType_t xRegion ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>BaseType_t xTaskSetPeriod_EDF( TaskHandle_t xTask, TickType_t xPeriod );</pre>
+ *
+ * Change the period of a periodic EDF task.  The job the task is executing
+ * keeps its deadline, the new period is used from the next release.  A
+ * relative deadline that was equal to the old period becomes equal to the new
+ * period, any other relative deadline is kept.
+ *
+ * If configUSE_EDF_ADMISSION_CONTROL is 1 the change is refused if the task
+ * set would no longer be schedulable with it.
+ *
+ * If configUSE_EDF_ELASTIC_TASKS is 1 xPeriod becomes the nominal (shortest)
+ * period of the task, and the task may be released with a longer period if
+ * the tasks would otherwise exceed configEDF_ELASTIC_UTILISATION - see
+ * vTaskSetElasticity_EDF().  The change is refused, and the old nominal period
+ * kept, if admission control refuses any of the periods the tasks would then
+ * be stretched to.
+ *
+ * @param xTask The handle of the task.  Passing NULL changes the period of the
+ * calling task.
+ *
+ * @param xPeriod The new period in ticks.
+ *
+ * @return pdPASS if the period was changed, otherwise pdFAIL.
+ *
+ * \defgroup xTaskSetPeriod_EDF xTaskSetPeriod_EDF
+ * \ingroup TaskCtrl
+ */
+#if( configUSE_EDF_SCHEDULER == 1 )
+	BaseType_t xTaskSetPeriod_EDF( TaskHandle_t xTask, TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>void vTaskSetElasticity_EDF( TaskHandle_t xTask, TickType_t xMinPeriod, TickType_t xMaxPeriod, UBaseType_t uxElasticity );</pre>
+ *
+ * configUSE_EDF_ELASTIC_TASKS must be defined as 1 for this function to be
+ * available.
+ *
+ * Make a periodic EDF task elastic.  While the total utilisation of the EDF
+ * tasks at their nominal periods is no more than configEDF_ELASTIC_UTILISATION
+ * percent every task runs at its nominal period.  When it is more, for example
+ * because a task was created or a period shortened, the periods of the elastic
+ * tasks are stretched, each compressing its utilisation in proportion to
+ * uxElasticity, until the target is met or every elastic task is at its
+ * maximum period.  Periods shrink back as soon as the load allows.
+ *
+ * The periods are recomputed each time a task is created or deleted, or its
+ * period or elasticity is changed.
+ *
+ * @param xTask The handle of the task.  Passing NULL makes the calling task
+ * elastic.
+ *
+ * @param xMinPeriod The nominal period of the task, used when there is no
+ * overload.
+ *
+ * @param xMaxPeriod The longest period the task can be stretched to.
+ *
+ * @param uxElasticity The elastic coefficient of the task.  A task with a
+ * larger coefficient gives up more of its utilisation.  0 makes the task rigid.
+ *
+ * \defgroup vTaskSetElasticity_EDF vTaskSetElasticity_EDF
+ * \ingroup TaskCtrl
+ */
+#if( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_ELASTIC_TASKS == 1 ) )
+	void vTaskSetElasticity_EDF( TaskHandle_t xTask, TickType_t xMinPeriod, TickType_t xMaxPeriod, UBaseType_t uxElasticity ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * <pre>BaseType_t xTaskAbortDelay( TaskHandle_t xTask );</pre>
@@ -2169,7 +2599,9 @@ BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
  *
  * The 'ordered' version uses the existing event list item value (which is the
  * owning tasks priority) to insert the list item into the event list is task
- * priority order.
+ * priority order.  When configUSE_EDF_SCHEDULER is 1 the event list item value
+ * is first set to the absolute deadline of the current job of the task, so the
+ * list is in deadline order instead.
  *
  * @param pxEventList The list containing tasks that are blocked waiting
  * for the event to occur.
@@ -2291,6 +2723,29 @@ BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder ) PRIVILEGE
  */
 void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder, UBaseType_t uxHighestPriorityWaitingTask ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Under EDF the tasks waiting for a mutex are ordered
+ * by deadline, so the list item values are not priorities.  Returns the
+ * highest priority of the tasks in pxEventList, or tskIDLE_PRIORITY if it is
+ * empty, for use with vTaskPriorityDisinheritAfterTimeout().
+ */
+UBaseType_t uxTaskGetHighestWaitingPriority_EDF( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Raise the Stack Resource Policy system ceiling to
+ * xCeiling, if xCeiling is higher than the current ceiling, when an SRP mutex
+ * is taken.  Returns the previous ceiling, which must be passed to
+ * xTaskRestoreSystemCeiling_SRP() when the mutex is given back.
+ */
+TickType_t xTaskRaiseSystemCeiling_SRP( TickType_t xCeiling ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Restore the system ceiling when an SRP mutex is
+ * given back, allowing the jobs that were held back by the ceiling to start.
+ * Returns pdTRUE if the calling task should yield.
+ */
+BaseType_t xTaskRestoreSystemCeiling_SRP( TickType_t xPreviousCeiling ) PRIVILEGED_FUNCTION;
+
 /*
  * Get the uxTCBNumber assigned to the task referenced by the xTask parameter.
  */
@@ -108,6 +108,13 @@ static volatile portLONG lIndexOfLastAddedTask = 0;
 static volatile unsigned portBASE_TYPE uxCriticalNesting;
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+	/* The longest time the tick can be suppressed for.  The timer could be set
+	for much longer, but the idle task waking this often costs nothing. */
+	static const TickType_t xMaximumPossibleSuppressedTicks = ( TickType_t ) 0x7fff;
+#endif
+/*-----------------------------------------------------------*/
+
 /*
  * Setup the timer to generate the tick interrupts.
  */
@@ -451,6 +458,74 @@ pthread_t xTaskToResume;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+struct itimerval itimer;
+sigset_t xTickSignal;
+sigset_t xPendingSignals;
+int iSignal;
+long long llMicroSeconds;
+
+	if ( xExpectedIdleTime > xMaximumPossibleSuppressedTicks )
+	{
+		xExpectedIdleTime = xMaximumPossibleSuppressedTicks;
+	}
+
+	/* Only the running thread takes the tick signal, so once this thread
+	blocks it nothing can run the tick handler while the timer is changed. */
+	sigemptyset( &xTickSignal );
+	sigaddset( &xTickSignal, SIG_TICK );
+	(void)pthread_sigmask( SIG_BLOCK, &xTickSignal, NULL );
+	(void)sigpending( &xPendingSignals );
+
+	/* A tick that is already pending has to be processed before the tick
+	count can be stepped, so sleep is abandoned as it is if a task was made
+	ready while the scheduler was suspended. */
+	if ( ( 1 == sigismember( &xPendingSignals, SIG_TICK ) ) || ( eAbortSleep == eTaskConfirmSleepModeStatus() ) )
+	{
+		(void)pthread_sigmask( SIG_UNBLOCK, &xTickSignal, NULL );
+	}
+	else if ( 0 == getitimer( TIMER_TYPE, &itimer ) )
+	{
+		/* Stretch the time left to the next tick by the ticks to be
+		suppressed.  The interval is left alone, so the periodic tick resumes
+		when the timer expires, in phase with the ticks before the sleep. */
+		llMicroSeconds = ( ( long long ) itimer.it_value.tv_sec * 1000000LL ) + ( long long ) itimer.it_value.tv_usec;
+		llMicroSeconds += ( long long ) ( xExpectedIdleTime - 1 ) * ( long long ) ( portTICK_PERIOD_MS * 1000 );
+		itimer.it_value.tv_sec = ( time_t ) ( llMicroSeconds / 1000000LL );
+		itimer.it_value.tv_usec = ( suseconds_t ) ( llMicroSeconds % 1000000LL );
+
+		if ( 0 != setitimer( TIMER_TYPE, &itimer, NULL ) )
+		{
+			printf( "Set Timer problem.\n" );
+		}
+
+		/* Nothing else can make a task ready while the idle task sleeps, so
+		the timer expiring is the only thing to wait for. */
+		if ( 0 != sigwait( &xTickSignal, &iSignal ) )
+		{
+			printf( "Tickless idle spurious signal: %d\n", iSignal );
+		}
+
+		/* Account for the ticks that were suppressed.  The last tick of the
+		sleep is raised again so the tick handler processes it as normal once
+		the signal is unblocked. */
+		vTaskStepTick( xExpectedIdleTime - 1 );
+		(void)pthread_kill( pthread_self(), SIG_TICK );
+		(void)pthread_sigmask( SIG_UNBLOCK, &xTickSignal, NULL );
+	}
+	else
+	{
+		printf( "Get Timer problem.\n" );
+		(void)pthread_sigmask( SIG_UNBLOCK, &xTickSignal, NULL );
+	}
+}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
 void vPortForciblyEndThread( void *pxTaskToDelete )
 {
 xTaskHandle hTaskToDelete = ( xTaskHandle )pxTaskToDelete;
@@ -31,6 +31,17 @@ typedef unsigned long UBaseType_t;
 #if( configUSE_16_BIT_TICKS == 1 )
     typedef uint16_t TickType_t;
     #define portMAX_DELAY ( TickType_t ) 0xffff
+#elif( configUSE_64_BIT_TICKS == 1 )
+    typedef uint64_t TickType_t;
+    #define portMAX_DELAY ( TickType_t ) 0xffffffffffffffffULL
+
+	/* Reads of a 64-bit tick count are only atomic on a 64-bit host.  A
+	32-bit build reads the tick count inside a critical section. */
+	#if defined( __LP64__ )
+		#define portTICK_TYPE_IS_ATOMIC 1
+	#else
+		#define portTICK_TYPE_IS_ATOMIC 0
+	#endif
 #else
     typedef uint32_t TickType_t;
     #define portMAX_DELAY ( TickType_t ) 0xffffffffUL
@@ -87,6 +98,13 @@ extern void vPortExitCritical( void );
 
 /*-----------------------------------------------------------*/
 
+/* Tickless idle.  The tick timer is set to expire at the end of the idle
+period rather than every tick. */
+extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	vPortSuppressTicksAndSleep( xExpectedIdleTime )
+
+/*-----------------------------------------------------------*/
+
 /* Task function macros as described on the FreeRTOS.org WEB site. */
 #define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void * pvParameters )
 #define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void * pvParameters )
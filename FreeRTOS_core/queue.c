@@ -120,6 +120,11 @@ typedef struct QueueDefinition
 		uint8_t ucQueueType;
 	#endif
 
+	#if ( configUSE_SRP_MUTEXES == 1 )
+		TickType_t xCeilingSRP;			/*< The ceiling of an SRP mutex - the shortest relative deadline of any task that takes it - or 0 if the queue is not an SRP mutex. */
+		TickType_t xPreviousCeilingSRP;	/*< The system ceiling before the SRP mutex was taken, restored when it is given back. */
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -437,6 +442,13 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	}
 	#endif /* configUSE_TRACE_FACILITY */
 
+	#if ( configUSE_SRP_MUTEXES == 1 )
+	{
+		pxNewQueue->xCeilingSRP = ( TickType_t ) 0U;
+		pxNewQueue->xPreviousCeilingSRP = portMAX_DELAY;
+	}
+	#endif /* configUSE_SRP_MUTEXES */
+
 	#if( configUSE_QUEUE_SETS == 1 )
 	{
 		pxNewQueue->pxQueueSetContainer = NULL;
@@ -493,6 +505,35 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_SRP_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateMutexSRP( TickType_t xCeiling )
+	{
+	Queue_t *pxNewQueue;
+
+		/* A ceiling of zero would never hold any job back. */
+		configASSERT( xCeiling != ( TickType_t ) 0U );
+
+		pxNewQueue = ( Queue_t * ) xQueueCreateMutex( queueQUEUE_TYPE_MUTEX );
+
+		/* The ceiling is only set once the mutex has been given for the first
+		time by prvInitialiseMutex(), so that give does not restore the system
+		ceiling. */
+		if( pxNewQueue != NULL )
+		{
+			pxNewQueue->xCeilingSRP = xCeiling;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxNewQueue;
+	}
+
+#endif /* configUSE_SRP_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 
 	QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType, StaticQueue_t *pxStaticQueue )
@@ -1432,6 +1473,19 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 						/* Record the information required to implement
 						priority inheritance should it become necessary. */
 						pxQueue->pxMutexHolder = ( int8_t * ) pvTaskIncrementMutexHeldCount(); /*lint !e961 Cast is not redundant as TaskHandle_t is a typedef. */
+
+						#if ( configUSE_SRP_MUTEXES == 1 )
+						{
+							if( pxQueue->xCeilingSRP != ( TickType_t ) 0U )
+							{
+								pxQueue->xPreviousCeilingSRP = xTaskRaiseSystemCeiling_SRP( pxQueue->xCeilingSRP );
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#endif /* configUSE_SRP_MUTEXES */
 					}
 					else
 					{
@@ -2022,14 +2076,25 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 		other tasks that are waiting for the same mutex.  For this purpose,
 		return the priority of the highest priority task that is waiting for the
 		mutex. */
-		if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0 )
+		#if ( configUSE_EDF_SCHEDULER == 1 )
 		{
-			uxHighestPriorityOfWaitingTasks = configMAX_PRIORITIES - listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+			/* Under EDF the waiting tasks are ordered by deadline, so the
+			value of the head entry is not a priority and the whole list has
+			to be searched. */
+			uxHighestPriorityOfWaitingTasks = uxTaskGetHighestWaitingPriority_EDF( &( pxQueue->xTasksWaitingToReceive ) );
 		}
-		else
+		#else
 		{
-			uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+			if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0 )
+			{
+				uxHighestPriorityOfWaitingTasks = configMAX_PRIORITIES - listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+			}
+			else
+			{
+				uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+			}
 		}
+		#endif /* configUSE_EDF_SCHEDULER */
 
 		return uxHighestPriorityOfWaitingTasks;
 	}
@@ -2055,6 +2120,26 @@ UBaseType_t uxMessagesWaiting;
 				/* The mutex is no longer being held. */
 				xReturn = xTaskPriorityDisinherit( ( void * ) pxQueue->pxMutexHolder );
 				pxQueue->pxMutexHolder = NULL;
+
+				#if ( configUSE_SRP_MUTEXES == 1 )
+				{
+					if( pxQueue->xCeilingSRP != ( TickType_t ) 0U )
+					{
+						if( xTaskRestoreSystemCeiling_SRP( pxQueue->xPreviousCeilingSRP ) != pdFALSE )
+						{
+							xReturn = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_SRP_MUTEXES */
 			}
 			else
 			{
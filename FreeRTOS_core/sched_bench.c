@@ -0,0 +1,472 @@
+/*
+ * Host benchmark for the EDF ready queue.
+ *
+ * Compares the sorted list previously used for the EDF ready tasks (vListInsert)
+ * with the deadline heap (deadline_heap.c) for 10 to 10,000 ready tasks.  Two
+ * costs are measured for each size:
+ *
+ * insert - placing a task into a ready queue that already holds n tasks.
+ * select - taking the earliest deadline task off the queue and releasing its
+ *          next job back into it, which is what happens each time a job
+ *          completes.
+ *
+ * It then compares two layouts of the EDF TCB for the same sizes: the layout
+ * where the members read on each scheduling decision were spread through the
+ * TCB, and the current layout (tasks.c) where they are grouped at its start.
+ * For each layout it reports the cache lines of a TCB a decision touches, the
+ * time per decision and, on Linux where the hardware counters can be read,
+ * the L1 data cache misses per decision.
+ *
+ * TCB_t is private to tasks.c, so the layouts are mirrored here.  tasks.c
+ * checks at compile time, with offsetof(), that the hot members of the real
+ * TCB_t lie within its first taskTCB_HOT_CACHE_LINES lines, and the grouped
+ * mirror is checked against the same bound below.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+	#include <unistd.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <linux/perf_event.h>
+#endif
+
+#include "FreeRTOS.h"
+#include "list.h"
+#include "deadline_heap.h"
+
+#define BENCH_SELECT_ROUNDS 20000
+#define BENCH_MAX_PERIOD 10000
+#define BENCH_DECISION_ROUNDS 200000
+#define BENCH_CACHE_LINE 64
+#define BENCH_HOT_CACHE_LINES 4	/* taskTCB_HOT_CACHE_LINES in tasks.c */
+
+typedef struct _benchTask
+{
+	ListItem_t xListItem;
+	DeadlineHeapItem_t xHeapItem;
+	TickType_t xPeriod;
+	TickType_t xDeadline;
+} benchTask;
+
+/*
+ * The EDF TCB as it was laid out before the hot members were grouped.  Members
+ * a scheduling decision does not read are replaced by padding of the same size.
+ */
+typedef struct _interleavedTask
+{
+	void *pxTopOfStack;
+	ListItem_t xStateListItem;
+	ListItem_t xEventListItem;
+	UBaseType_t uxPriority;
+	uint8_t ucCold1[48];	/* pxStack, pcTaskName, tag, notification state */
+	uint32_t ulRunTimeCounter;
+	uint8_t ucCold2[8];
+	DeadlineHeapItem_t xStateHeapItem;
+	TickType_t xTaskPeriod;
+	uint8_t ucCold3[8];		/* xTaskDeadline, xJobRelease */
+	TickType_t xJobDeadline;
+	uint8_t ucCold4[8];		/* uxJobNumber */
+	uint8_t ucWaitingForRelease;
+	DeadlineHeapItem_t xDeadlineHeapItem;
+	uint8_t ucCold5[24];	/* miss and tardiness statistics */
+	TickType_t xTaskWCET;
+	TickType_t xServerBudget;
+	TickType_t xRemainingBudget;
+	TickType_t xJobExecutionTime;
+	uint8_t ucCold6[16];	/* xMaxExecutionTime, uxBudgetOverruns */
+	uint8_t ucJobOverrun;
+	uint8_t ucCold7[40];	/* overrun action and sporadic arrivals */
+	uint8_t ucJobStarted;
+	TickType_t xNonPreemptiveRegion;
+	TickType_t xNonPreemptiveTicksLeft;
+	uint8_t ucPreemptionDeferred;
+	uint8_t ucCold8[152];	/* admission, elastic and (m,k)-firm members */
+} interleavedTask;
+
+/*
+ * The EDF TCB as it is laid out now, with the members read on every
+ * scheduling decision directly after pxTopOfStack.
+ */
+typedef struct _groupedTask
+{
+	void *pxTopOfStack;
+	DeadlineHeapItem_t xStateHeapItem;
+	TickType_t xJobDeadline;
+	TickType_t xJobExecutionTime;
+	TickType_t xTaskWCET;
+	TickType_t xServerBudget;
+	TickType_t xRemainingBudget;
+	TickType_t xTaskPeriod;
+	ListItem_t xStateListItem;
+	ListItem_t xEventListItem;
+	UBaseType_t uxPriority;
+	uint32_t ulRunTimeCounter;
+	TickType_t xNonPreemptiveTicksLeft;
+	uint8_t ucPreemptionDeferred;
+	uint8_t ucJobStarted;
+	uint8_t ucWaitingForRelease;
+	uint8_t ucJobOverrun;
+	uint8_t ucCold[360];	/* every other member */
+} groupedTask;
+
+/* Fails to compile if the grouped mirror no longer fits the bound tasks.c
+enforces on the real TCB_t. */
+typedef char groupedTaskHotLinesCheck[(offsetof(groupedTask, ucCold) <= BENCH_CACHE_LINE * BENCH_HOT_CACHE_LINES) ? 1 : -1];
+
+/* A member read on each scheduling decision, used to count the cache lines of
+a TCB that a decision touches. */
+typedef struct _hotMember
+{
+	size_t xOffset;
+	size_t xSize;
+} hotMember;
+
+#define benchHOT_MEMBER( type, member ) { offsetof( type, member ), sizeof( ( ( type * ) 0 )->member ) }
+
+#define benchHOT_MEMBERS( type )							\
+{															\
+	benchHOT_MEMBER( type, pxTopOfStack ),					\
+	benchHOT_MEMBER( type, xStateHeapItem ),				\
+	benchHOT_MEMBER( type, xJobDeadline ),					\
+	benchHOT_MEMBER( type, xJobExecutionTime ),				\
+	benchHOT_MEMBER( type, xTaskWCET ),						\
+	benchHOT_MEMBER( type, xServerBudget ),					\
+	benchHOT_MEMBER( type, xRemainingBudget ),				\
+	benchHOT_MEMBER( type, xTaskPeriod ),					\
+	benchHOT_MEMBER( type, xStateListItem ),				\
+	benchHOT_MEMBER( type, uxPriority ),					\
+	benchHOT_MEMBER( type, ulRunTimeCounter ),				\
+	benchHOT_MEMBER( type, xNonPreemptiveTicksLeft ),		\
+	benchHOT_MEMBER( type, ucPreemptionDeferred ),			\
+	benchHOT_MEMBER( type, ucJobStarted ),					\
+	benchHOT_MEMBER( type, ucJobOverrun )					\
+}
+
+/*
+ * One scheduling decision, made the way the tick and vTaskSwitchContext() make
+ * it: take the task at the head of the ready heap, check whether it may be
+ * preempted, charge it a tick of execution and its budget, then complete its
+ * job and release the next one back into the heap.
+ */
+#define benchSCHEDULING_DECISION( type, pxReady, ulChecksum )							\
+{																						\
+	type *pxTask = ( type * ) heapGET_OWNER_OF_HEAD_ITEM( pxReady );					\
+																						\
+	( ulChecksum ) += pxTask->uxPriority;												\
+	( ulChecksum ) += ( listLIST_ITEM_CONTAINER( &pxTask->xStateListItem ) == NULL );	\
+	pxTask->ucJobStarted = pdTRUE;														\
+	if( pxTask->ucPreemptionDeferred == pdFALSE )										\
+	{																					\
+		pxTask->xNonPreemptiveTicksLeft = 0;											\
+	}																					\
+	pxTask->xJobExecutionTime++;														\
+	pxTask->ulRunTimeCounter++;															\
+	if( pxTask->xServerBudget != 0 )													\
+	{																					\
+		pxTask->xRemainingBudget--;														\
+	}																					\
+	if( pxTask->xJobExecutionTime > pxTask->xTaskWCET )									\
+	{																					\
+		pxTask->ucJobOverrun = pdTRUE;													\
+	}																					\
+																						\
+	(void)uxDeadlineHeapRemove( &pxTask->xStateHeapItem );								\
+	pxTask->xJobDeadline += pxTask->xTaskPeriod;										\
+	pxTask->xJobExecutionTime = 0;														\
+	pxTask->ucJobStarted = pdFALSE;														\
+	heapSET_HEAP_ITEM_VALUE( &pxTask->xStateHeapItem, pxTask->xJobDeadline );			\
+	vDeadlineHeapInsert( pxReady, &pxTask->xStateHeapItem );							\
+}
+
+/*
+ * Defines a function that fills a ready heap with numTask TCBs of the given
+ * layout, each starting on a cache line like a TCB from malloc() on most
+ * hosts, then times BENCH_DECISION_ROUNDS scheduling decisions.  Returns -1 if
+ * the TCBs cannot be allocated, otherwise 0.
+ */
+#define benchLAYOUT_FUNCTION( name, type )												\
+static int name(int numTask, double *decisionNs, double *missesPerDecision)			\
+{																						\
+	size_t stride = (sizeof(type) + BENCH_CACHE_LINE - 1) & ~(size_t)(BENCH_CACHE_LINE - 1); \
+	unsigned char *buffer = (unsigned char *)aligned_alloc(BENCH_CACHE_LINE, stride * numTask); \
+	DeadlineHeap_t xReady;																\
+	unsigned int seed = 1;																\
+	unsigned long ulChecksum = 0;														\
+	long long misses;																	\
+	double start;																		\
+																						\
+	if (buffer == NULL) {																\
+		printf("[ERROR] cannot allocate %d TCBs for %s\n", numTask, #name);			\
+		return -1;																		\
+	}																					\
+	memset(buffer, 0, stride * numTask);												\
+	vDeadlineHeapInitialise(&xReady);													\
+	for (int i = 0; i < numTask; i++) {													\
+		type *pxTask = (type *)(buffer + stride * i);									\
+		pxTask->xTaskPeriod = 1 + nextRandom(&seed) % BENCH_MAX_PERIOD;				\
+		pxTask->xJobDeadline = pxTask->xTaskPeriod;										\
+		pxTask->xTaskWCET = pxTask->xTaskPeriod;										\
+		vDeadlineHeapInitialiseItem(&pxTask->xStateHeapItem);							\
+		heapSET_HEAP_ITEM_OWNER(&pxTask->xStateHeapItem, pxTask);						\
+		heapSET_HEAP_ITEM_VALUE(&pxTask->xStateHeapItem, pxTask->xJobDeadline);			\
+		vDeadlineHeapInsert(&xReady, &pxTask->xStateHeapItem);							\
+	}																					\
+																						\
+	startMissCounter();																	\
+	start = getTimeNs();																\
+	for (int i = 0; i < BENCH_DECISION_ROUNDS; i++) {									\
+		benchSCHEDULING_DECISION(type, &xReady, ulChecksum);							\
+	}																					\
+	*decisionNs = (getTimeNs() - start) / BENCH_DECISION_ROUNDS;						\
+	misses = stopMissCounter();															\
+	*missesPerDecision = (misses < 0) ? -1.0 : (double)misses / BENCH_DECISION_ROUNDS;	\
+																						\
+	if (ulChecksum == 0) {																\
+		printf("[ERROR] no decision was made\n");										\
+	}																					\
+	free(buffer);																		\
+	return 0;																			\
+}
+
+/* Function prototypes */
+void vAssertCalled( unsigned long ulLine, const char * const pcFileName );
+static double getTimeNs(void);
+static unsigned int nextRandom(unsigned int *seed);
+static void initTasks(benchTask *tasks, int numTask);
+static void benchList(benchTask *tasks, int numTask, double *insertNs, double *selectNs);
+static void benchHeap(benchTask *tasks, int numTask, double *insertNs, double *selectNs);
+static int countHotLines(const hotMember *members, int numMembers);
+static void openMissCounter(void);
+static void startMissCounter(void);
+static long long stopMissCounter(void);
+static void formatMisses(char *text, size_t size, double missesPerDecision);
+static int benchInterleaved(int numTask, double *decisionNs, double *missesPerDecision);
+static int benchGrouped(int numTask, double *decisionNs, double *missesPerDecision);
+
+/* File descriptor of the L1 data cache miss counter, or -1 if it cannot be read */
+static int missCounter = -1;
+
+void vAssertCalled( unsigned long ulLine, const char * const pcFileName )
+{
+	printf("[ASSERT] %s:%lu\n", pcFileName, ulLine);
+	exit(-1);
+}
+
+static double getTimeNs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* Deterministic so both queues see the same deadlines */
+static unsigned int nextRandom(unsigned int *seed)
+{
+	*seed = *seed * 1103515245u + 12345u;
+	return (*seed >> 16) & 0x7fff;
+}
+
+static void initTasks(benchTask *tasks, int numTask)
+{
+	unsigned int seed = 1;
+
+	for (int i = 0; i < numTask; i++) {
+		tasks[i].xPeriod = 1 + nextRandom(&seed) % BENCH_MAX_PERIOD;
+		tasks[i].xDeadline = tasks[i].xPeriod;
+	}
+}
+
+static void benchList(benchTask *tasks, int numTask, double *insertNs, double *selectNs)
+{
+	List_t xReady;
+	benchTask *pxTask;
+	double start;
+
+	initTasks(tasks, numTask);
+	vListInitialise(&xReady);
+
+	start = getTimeNs();
+	for (int i = 0; i < numTask; i++) {
+		vListInitialiseItem(&tasks[i].xListItem);
+		listSET_LIST_ITEM_OWNER(&tasks[i].xListItem, &tasks[i]);
+		listSET_LIST_ITEM_VALUE(&tasks[i].xListItem, tasks[i].xDeadline);
+		vListInsert(&xReady, &tasks[i].xListItem);
+	}
+	*insertNs = (getTimeNs() - start) / numTask;
+
+	start = getTimeNs();
+	for (int i = 0; i < BENCH_SELECT_ROUNDS; i++) {
+		pxTask = (benchTask *)listGET_OWNER_OF_HEAD_ENTRY(&xReady);
+		(void)uxListRemove(&pxTask->xListItem);
+		pxTask->xDeadline += pxTask->xPeriod;
+		listSET_LIST_ITEM_VALUE(&pxTask->xListItem, pxTask->xDeadline);
+		vListInsert(&xReady, &pxTask->xListItem);
+	}
+	*selectNs = (getTimeNs() - start) / BENCH_SELECT_ROUNDS;
+}
+
+static void benchHeap(benchTask *tasks, int numTask, double *insertNs, double *selectNs)
+{
+	DeadlineHeap_t xReady;
+	benchTask *pxTask;
+	double start;
+
+	initTasks(tasks, numTask);
+	vDeadlineHeapInitialise(&xReady);
+
+	start = getTimeNs();
+	for (int i = 0; i < numTask; i++) {
+		vDeadlineHeapInitialiseItem(&tasks[i].xHeapItem);
+		heapSET_HEAP_ITEM_OWNER(&tasks[i].xHeapItem, &tasks[i]);
+		heapSET_HEAP_ITEM_VALUE(&tasks[i].xHeapItem, tasks[i].xDeadline);
+		vDeadlineHeapInsert(&xReady, &tasks[i].xHeapItem);
+	}
+	*insertNs = (getTimeNs() - start) / numTask;
+
+	start = getTimeNs();
+	for (int i = 0; i < BENCH_SELECT_ROUNDS; i++) {
+		pxTask = (benchTask *)heapGET_OWNER_OF_HEAD_ITEM(&xReady);
+		(void)uxDeadlineHeapRemove(&pxTask->xHeapItem);
+		pxTask->xDeadline += pxTask->xPeriod;
+		heapSET_HEAP_ITEM_VALUE(&pxTask->xHeapItem, pxTask->xDeadline);
+		vDeadlineHeapInsert(&xReady, &pxTask->xHeapItem);
+	}
+	*selectNs = (getTimeNs() - start) / BENCH_SELECT_ROUNDS;
+}
+
+/* The number of cache lines the members span in a TCB that starts on a line */
+static int countHotLines(const hotMember *members, int numMembers)
+{
+	unsigned char touched[1024 / BENCH_CACHE_LINE] = {0};
+	int lines = 0;
+
+	for (int i = 0; i < numMembers; i++) {
+		size_t first = members[i].xOffset / BENCH_CACHE_LINE;
+		size_t last = (members[i].xOffset + members[i].xSize - 1) / BENCH_CACHE_LINE;
+
+		for (size_t line = first; line <= last; line++) {
+			if (!touched[line]) {
+				touched[line] = 1;
+				lines++;
+			}
+		}
+	}
+	return lines;
+}
+
+static void openMissCounter(void)
+{
+#ifdef __linux__
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HW_CACHE;
+	attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	missCounter = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+}
+
+static void startMissCounter(void)
+{
+#ifdef __linux__
+	if (missCounter >= 0) {
+		ioctl(missCounter, PERF_EVENT_IOC_RESET, 0);
+		ioctl(missCounter, PERF_EVENT_IOC_ENABLE, 0);
+	}
+#endif
+}
+
+/* Returns the misses counted since startMissCounter(), or -1 if unavailable */
+static long long stopMissCounter(void)
+{
+#ifdef __linux__
+	long long count;
+
+	if (missCounter >= 0) {
+		ioctl(missCounter, PERF_EVENT_IOC_DISABLE, 0);
+		if (read(missCounter, &count, sizeof(count)) == sizeof(count)) {
+			return count;
+		}
+	}
+#endif
+	return -1;
+}
+
+/* The miss columns read n/a when the hardware counters cannot be read */
+static void formatMisses(char *text, size_t size, double missesPerDecision)
+{
+	if (missesPerDecision < 0) {
+		snprintf(text, size, "n/a");
+	} else {
+		snprintf(text, size, "%.2f", missesPerDecision);
+	}
+}
+
+benchLAYOUT_FUNCTION(benchInterleaved, interleavedTask)
+benchLAYOUT_FUNCTION(benchGrouped, groupedTask)
+
+int main()
+{
+	int sizes[] = {10, 100, 1000, 10000};
+	int numSizes = sizeof(sizes) / sizeof(int);
+	double listInsert, listSelect, heapInsert, heapSelect;
+
+	printf("EDF ready queue cost (ns per operation)\n");
+	printf("%8s | %12s %12s | %12s %12s\n", "tasks", "list insert", "list select", "heap insert", "heap select");
+
+	for (int i = 0; i < numSizes; i++) {
+		benchTask *tasks = (benchTask *)malloc(sizeof(benchTask) * sizes[i]);
+
+		if (tasks == NULL) {
+			printf("[ERROR] cannot allocate %d tasks\n", sizes[i]);
+			return 1;
+		}
+		benchList(tasks, sizes[i], &listInsert, &listSelect);
+		benchHeap(tasks, sizes[i], &heapInsert, &heapSelect);
+		printf("%8d | %12.1f %12.1f | %12.1f %12.1f\n", sizes[i], listInsert, listSelect, heapInsert, heapSelect);
+
+		free(tasks);
+	}
+
+	hotMember interleavedMembers[] = benchHOT_MEMBERS(interleavedTask);
+	hotMember groupedMembers[] = benchHOT_MEMBERS(groupedTask);
+	int numMembers = sizeof(groupedMembers) / sizeof(hotMember);
+	int interleavedLines = countHotLines(interleavedMembers, numMembers);
+	int groupedLines = countHotLines(groupedMembers, numMembers);
+	double interleavedNs, interleavedMisses, groupedNs, groupedMisses;
+	char interleavedText[16], groupedText[16];
+
+	/* The hot lines columns count the cache lines the decisions can touch over
+	 * all the TCBs.  They are derived from the layouts, not measured, so they
+	 * show where the grouped layout can save misses even when the L1D columns
+	 * read n/a */
+	openMissCounter();
+	printf("\nEDF TCB layout, cost per scheduling decision (hot lines per TCB: interleaved %d, grouped %d)\n",
+		interleavedLines, groupedLines);
+	printf("%8s | %12s %12s %12s | %12s %12s %12s\n", "tasks", "interl. hot", "interl. ns", "interl. L1D",
+		"grouped hot", "grouped ns", "grouped L1D");
+
+	for (int i = 0; i < numSizes; i++) {
+		if (benchInterleaved(sizes[i], &interleavedNs, &interleavedMisses) != 0 ||
+			benchGrouped(sizes[i], &groupedNs, &groupedMisses) != 0) {
+			return 1;
+		}
+
+		formatMisses(interleavedText, sizeof(interleavedText), interleavedMisses);
+		formatMisses(groupedText, sizeof(groupedText), groupedMisses);
+		printf("%8d | %12d %12.1f %12s | %12d %12.1f %12s\n", sizes[i], sizes[i] * interleavedLines, interleavedNs,
+			interleavedText, sizes[i] * groupedLines, groupedNs, groupedText);
+	}
+	return 0;
+}
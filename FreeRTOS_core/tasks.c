@@ -27,6 +27,7 @@
 
 /* Standard includes. */
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 
 /* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
@@ -40,6 +41,10 @@ task.h is included from an application file. */
 #include "timers.h"
 #include "stack_macros.h"
 
+#if ( configUSE_EDF_SCHEDULER == 1 )
+	#include "deadline_heap.h"
+#endif
+
 /* Lint e961 and e750 are suppressed as a MISRA exception justified because the
 MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
 header files above, but not in this file, in order to generate the correct
@@ -198,20 +203,33 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	/* A port optimised version is provided, call it only if the TCB being reset
 	is being referenced from a ready list.  If it is referenced from a delayed
 	or suspended list then it won't be in a ready list. */
-	#define taskRESET_READY_PRIORITY( uxPriority )														\
-	{																									\
-		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 )	\
-		{																								\
-			portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );							\
-		}																								\
-	}
+	#if ( configUSE_EDF_SCHEDULER == 0 )
+		#define taskRESET_READY_PRIORITY( uxPriority )														\
+		{																									\
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 )	\
+			{																								\
+				portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );							\
+			}																								\
+		}
+	#else
+		#define taskRESET_READY_PRIORITY( uxPriority )														\
+		{																									\
+			if( heapHEAP_IS_EMPTY( taskREADY_HEAP_EDF( uxPriority ) ) != pdFALSE )							\
+			{																								\
+				portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );							\
+			}																								\
+		}
+	#endif
 
 #endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 /*-----------------------------------------------------------*/
 
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
-count overflows. */
+count overflows.  A 64-bit tick count does not overflow in the lifetime of the
+system, so then there is only one delayed list. */
+#if( configUSE_64_BIT_TICKS == 0 )
+
 #define taskSWITCH_DELAYED_LISTS()																	\
 {																									\
 	List_t *pxTemp;																					\
@@ -226,6 +244,8 @@ count overflows. */
 	prvResetNextTaskUnblockTime();																	\
 }
 
+#endif /* configUSE_64_BIT_TICKS */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -238,13 +258,141 @@ count overflows. */
 		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
 		vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ) \
 		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+
+	#define prvAddUnblockedTaskToReadyList( pxTCB ) prvAddTaskToReadyList( pxTCB )
 #else
+	/* Under EDF the ready tasks are held in a heap ordered by deadline rather
+	than in a list, so the task is referenced from the heap through its
+	xStateHeapItem and its xStateListItem is left unused while it is ready. */
 	#define prvAddTaskToReadyList( pxTCB )																\
 		traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
 		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
-		vListInsert( &(xReadyTasksListEDF), &( ( pxTCB )->xStateListItem ) ) \
+		heapSET_HEAP_ITEM_VALUE( &( ( pxTCB )->xStateHeapItem ), taskSCHEDULING_KEY_EDF( pxTCB ) );	\
+		vDeadlineHeapInsert( taskREADY_HEAP_EDF( ( pxTCB )->uxPriority ), &( ( pxTCB )->xStateHeapItem ) );	\
 		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
-#endif				
+
+	/* As prvAddTaskToReadyList(), but used only where the task is leaving the
+	Blocked or Suspended state.  A CBS server is given a fresh deadline and
+	budget if its old ones cannot be kept.  Tasks that are only being
+	repositioned in the ready heap, for example by priority inheritance, keep
+	their server deadline. */
+	#define prvAddUnblockedTaskToReadyList( pxTCB )														\
+		if( ( pxTCB )->xServerBudget != ( TickType_t ) 0U )												\
+		{																								\
+			prvWakeServer_CBS( pxTCB );																	\
+		}																								\
+		prvAddTaskToReadyList( pxTCB )
+
+	/* The value the ready heap is ordered by under the scheduling policy set
+	by configEDF_SCHEDULING_POLICY - the task with the lowest value runs.  A
+	task without timing parameters has a value of 0 under every policy, and a
+	job demoted by eOverrunDemote has a deadline of portMAX_DELAY, which every
+	policy maps to portMAX_DELAY.  Inserting into the heap, selecting the next
+	task and testing for preemption all use the same value, so changing the
+	policy needs no other change to the scheduler.
+
+	Under least laxity first the laxity of a job at time t is its deadline,
+	less t, less the part of its WCET it has yet to execute.  t is the same for
+	every task, so it is left out.  The value of the running task then grows
+	by one for each tick it executes, and the tick interrupt repositions it in
+	the ready heap, while the value of every other task is unchanged.  A job
+	whose remaining WCET is longer than its absolute deadline has a value of 0
+	rather than one that wraps to the back of the heap. */
+	#if ( configEDF_SCHEDULING_POLICY == edfPOLICY_EDF )
+		#define taskSCHEDULING_KEY_EDF( pxTCB )	( ( pxTCB )->xJobDeadline )
+	#elif ( configEDF_SCHEDULING_POLICY == edfPOLICY_RM )
+		#define taskSCHEDULING_KEY_EDF( pxTCB )	( ( ( pxTCB )->xJobDeadline == portMAX_DELAY ) ? portMAX_DELAY : ( pxTCB )->xTaskPeriod )
+	#elif ( configEDF_SCHEDULING_POLICY == edfPOLICY_DM )
+		#define taskSCHEDULING_KEY_EDF( pxTCB )	( ( ( pxTCB )->xJobDeadline == portMAX_DELAY ) ? portMAX_DELAY : ( pxTCB )->xTaskDeadline )
+	#elif ( configEDF_SCHEDULING_POLICY == edfPOLICY_LLF )
+		#define taskREMAINING_WCET_EDF( pxTCB )	( ( ( pxTCB )->xTaskWCET > ( pxTCB )->xJobExecutionTime ) ? ( ( pxTCB )->xTaskWCET - ( pxTCB )->xJobExecutionTime ) : ( TickType_t ) 0U )
+		#define taskSCHEDULING_KEY_EDF( pxTCB )	( ( ( pxTCB )->xJobDeadline == portMAX_DELAY ) ? portMAX_DELAY : ( ( ( pxTCB )->xJobDeadline > taskREMAINING_WCET_EDF( pxTCB ) ) ? ( ( pxTCB )->xJobDeadline - taskREMAINING_WCET_EDF( pxTCB ) ) : ( TickType_t ) 0U ) )
+	#else
+		#error configEDF_SCHEDULING_POLICY must be one of edfPOLICY_EDF, edfPOLICY_RM, edfPOLICY_DM or edfPOLICY_LLF
+	#endif
+
+	/* True if pxA is ahead of pxB in the order tasks are selected to run - it
+	is in a higher priority band, or has a lower value in the same band. */
+	#if ( configUSE_EDF_PRIORITY_BANDS == 1 )
+		#define taskRUNS_BEFORE_EDF( pxA, pxB )	( ( ( pxA )->uxPriority > ( pxB )->uxPriority ) || ( ( ( pxA )->uxPriority == ( pxB )->uxPriority ) && ( taskSCHEDULING_KEY_EDF( pxA ) < taskSCHEDULING_KEY_EDF( pxB ) ) ) )
+	#else
+		#define taskRUNS_BEFORE_EDF( pxA, pxB )	( taskSCHEDULING_KEY_EDF( pxA ) < taskSCHEDULING_KEY_EDF( pxB ) )
+	#endif
+
+	/* True if the job of pxTCB may not start until the SRP system ceiling is
+	lowered.  A job that has started, such as the holder of the mutex that set
+	the ceiling, is never held back, and neither is a task without timing
+	parameters. */
+	#if ( configUSE_SRP_MUTEXES == 1 )
+		#define taskIS_HELD_BY_CEILING_SRP( pxTCB )	( ( ( pxTCB )->ucJobStarted == pdFALSE ) && ( ( pxTCB )->xTaskDeadline != ( TickType_t ) 0U ) && ( ( pxTCB )->xTaskDeadline >= xSystemCeilingSRP ) )
+	#else
+		#define taskIS_HELD_BY_CEILING_SRP( pxTCB )	( pdFALSE )
+	#endif
+
+	/* The ready heap that holds the ready tasks of priority uxPriority.  With
+	configUSE_EDF_PRIORITY_BANDS set to 1 each priority is a band with its own
+	heap, so the priority of a task is only compared with the priority of
+	tasks in other bands and deadlines are only compared within a band.
+	Otherwise every ready task is in the same heap. */
+	#if ( configUSE_EDF_PRIORITY_BANDS == 1 )
+		#define taskREADY_HEAP_EDF( uxPriority )	( &( xReadyTasksHeapsEDF[ ( uxPriority ) ] ) )
+	#else
+		#define taskREADY_HEAP_EDF( uxPriority )	( ( void ) ( uxPriority ), &( xReadyTasksHeapEDF ) )
+	#endif
+#endif
+/*-----------------------------------------------------------*/
+
+/*
+ * Remove the task from whichever list its state is referenced from, which
+ * under EDF may be the ready heap, and evaluate to the number of items left
+ * in that list.  taskIS_IN_READY_LIST() is true if the task is referenced from
+ * the ready list used for uxPriority.
+ */
+#if (configUSE_EDF_SCHEDULER == 0)
+	#define taskREMOVE_FROM_STATE_LIST( pxTCB )	uxListRemove( &( ( pxTCB )->xStateListItem ) )
+	#define taskIS_IN_READY_LIST( pxTCB, uxPriority ) listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ ( uxPriority ) ] ), &( ( pxTCB )->xStateListItem ) )
+#else
+	#define taskREMOVE_FROM_STATE_LIST( pxTCB )	prvRemoveTaskFromStateList( pxTCB )
+
+	/* True for a task created with xTaskCreate_EDF() or
+	xTaskCreateSporadic_EDF(), whose jobs are released periodically or
+	sporadically, and false for a CBS task or a task without timing
+	parameters. */
+	#define taskIS_PERIODIC_EDF( pxTCB ) ( ( ( pxTCB )->xTaskPeriod != ( TickType_t ) 0U ) && ( ( pxTCB )->xServerBudget == ( TickType_t ) 0U ) )
+
+	/* True for a task that is blocked in the release heap until its next job
+	is released. */
+	#define taskIS_WAITING_FOR_RELEASE_EDF( pxTCB ) heapIS_CONTAINED_WITHIN( pxReleaseHeapEDF, &( ( pxTCB )->xStateHeapItem ) )
+
+	/* A job held back by the SRP system ceiling is still ready, so a task in
+	xCeilingBlockedHeapSRP counts as being in the ready list.  Code that
+	re-keys a ready task removes it from whichever heap it is in and inserts it
+	into the ready heap, and the ceiling is applied again before the next task
+	is selected to run. */
+	#if ( configUSE_SRP_MUTEXES == 1 )
+		#define taskIS_IN_READY_LIST( pxTCB, uxPriority ) ( ( heapIS_CONTAINED_WITHIN( taskREADY_HEAP_EDF( uxPriority ), &( ( pxTCB )->xStateHeapItem ) ) != pdFALSE ) || ( heapIS_CONTAINED_WITHIN( &xCeilingBlockedHeapSRP, &( ( pxTCB )->xStateHeapItem ) ) != pdFALSE ) )
+	#else
+		#define taskIS_IN_READY_LIST( pxTCB, uxPriority ) heapIS_CONTAINED_WITHIN( taskREADY_HEAP_EDF( uxPriority ), &( ( pxTCB )->xStateHeapItem ) )
+	#endif
+#endif
+/*-----------------------------------------------------------*/
+
+/*
+ * Decide whether a task that has just been made ready should preempt the
+ * running task.  taskHAS_PRIORITY_OVER_CURRENT() is used where the original
+ * test was for a strictly higher priority, and
+ * taskHAS_PRIORITY_OF_CURRENT_OR_ABOVE() where a task of equal priority also
+ * caused a yield, so equal priority tasks are round robin scheduled.  Under EDF
+ * both only hold if the job of the task has an earlier deadline than the job
+ * of the running task, so tasks with equal deadlines are not switched between.
+ */
+#if (configUSE_EDF_SCHEDULER == 0)
+	#define taskHAS_PRIORITY_OVER_CURRENT( pxTCB )			( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+	#define taskHAS_PRIORITY_OF_CURRENT_OR_ABOVE( pxTCB )	( ( pxTCB )->uxPriority >= pxCurrentTCB->uxPriority )
+#else
+	#define taskHAS_PRIORITY_OVER_CURRENT( pxTCB )			prvPreemptsCurrentTask_EDF( pxTCB )
+	#define taskHAS_PRIORITY_OF_CURRENT_OR_ABOVE( pxTCB )	prvPreemptsCurrentTask_EDF( pxTCB )
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -265,6 +413,8 @@ responsibility of whichever module is using the value to ensure it gets set back
 to its original value when it is released. */
 #if( configUSE_16_BIT_TICKS == 1 )
 	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x8000U
+#elif( configUSE_64_BIT_TICKS == 1 )
+	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x8000000000000000ULL
 #else
 	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x80000000UL
 #endif
@@ -282,9 +432,47 @@ typedef struct tskTaskControlBlock
 		xMPU_SETTINGS	xMPUSettings;		/*< The MPU settings are defined as part of the port layer.  THIS MUST BE THE SECOND MEMBER OF THE TCB STRUCT. */
 	#endif
 
+	/* The members the scheduler reads each time it walks the ready, delayed or
+	event lists, charges a tick to the running task or selects the next task to
+	run are kept together here, directly after the members the port needs at a
+	fixed offset.  A scheduling decision then touches a few consecutive cache
+	lines of each TCB it visits instead of lines spread across the whole TCB.
+	Members that are only used when a task is created, when a job completes or
+	by the statistics and debug functions follow the hot members. */
+	#if( configUSE_EDF_SCHEDULER == 1 )
+		DeadlineHeapItem_t	xStateHeapItem;	/*< References the task from the EDF ready heap while it is in the Ready state. */
+		TickType_t xJobDeadline;			/*< The absolute deadline of the current job - the key the ready heap is ordered by under edfPOLICY_EDF. */
+		TickType_t xJobExecutionTime;		/*< The number of ticks the current job has run for. */
+		TickType_t xTaskWCET;				/*< The worst case execution time declared for each job, or 0 if none was declared. */
+		TickType_t xServerBudget;			/*< The budget Q of a task created with xTaskCreate_CBS(), or 0 for any other task.  xTaskPeriod holds the server period and xJobDeadline the server deadline. */
+		TickType_t xRemainingBudget;		/*< The budget left before the server deadline of a CBS task is postponed. */
+		TickType_t xTaskPeriod;				/*< The period of the task, or 0 if the task was not created with xTaskCreate_EDF(). */
+	#endif
+
 	ListItem_t			xStateListItem;	/*< The list that the state list item of a task is reference from denotes the state of that task (Ready, Blocked, Suspended ). */
 	ListItem_t			xEventListItem;		/*< Used to reference a task from an event list. */
 	UBaseType_t			uxPriority;			/*< The priority of the task.  0 is the lowest priority. */
+
+	#if( configGENERATE_RUN_TIME_STATS == 1 )
+		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+	#endif
+
+	#if( configUSE_EDF_SCHEDULER == 1 )
+		#if ( configUSE_EDF_LIMITED_PREEMPTION == 1 )
+			TickType_t xNonPreemptiveTicksLeft;	/*< The ticks left in the non-preemptive region the task is currently executing. */
+			uint8_t ucPreemptionDeferred;		/*< Set to pdTRUE while the task is executing a non-preemptive region. */
+		#endif
+
+		#if ( configUSE_SRP_MUTEXES == 1 )
+			uint8_t ucJobStarted;			/*< Set to pdTRUE once the current job has been selected to run.  Under the Stack Resource Policy only a job that has not started can be held back by the system ceiling. */
+		#endif
+
+		uint8_t ucWaitingForRelease;		/*< Set to pdTRUE while the task is blocked until its next job is released. */
+		uint8_t ucJobOverrun;				/*< Set to pdTRUE once the current job has overrun xTaskWCET, so the overrun is only acted on once. */
+	#endif
+
+	/* End of the members used on every scheduling decision. */
+
 	StackType_t			*pxStack;			/*< Points to the start of the stack. */
 	char				pcTaskName[ configMAX_TASK_NAME_LEN ];/*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
@@ -314,10 +502,6 @@ typedef struct tskTaskControlBlock
 		void			*pvThreadLocalStoragePointers[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
 
-	#if( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
-	#endif
-
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		/* Allocate a Newlib reent structure that is specific to this task.
 		Note Newlib support has been included by popular demand, but is not
@@ -344,9 +528,43 @@ typedef struct tskTaskControlBlock
 		uint8_t ucDelayAborted;
 	#endif
 	#if( configUSE_EDF_SCHEDULER == 1 )
-		TickType_t xTaskPeriod;
-		TickType_t xTaskDeadline;
-	#endif	
+		TickType_t xTaskDeadline;			/*< The deadline of each job relative to its release. */
+		TickType_t xJobRelease;				/*< The time at which the current job was released. */
+		UBaseType_t uxJobNumber;			/*< The number of jobs released so far.  The first job is job 1. */
+		DeadlineHeapItem_t	xDeadlineHeapItem;	/*< References the task from the heap of outstanding jobs from the release of a job until it completes or misses its deadline. */
+		UBaseType_t uxDeadlineMisses;		/*< The number of jobs that missed their deadline. */
+		TickType_t xMaxLateness;			/*< The largest amount by which a job completed after its deadline. */
+		TickType_t xTotalTardiness;			/*< The sum of the amounts by which jobs completed after their deadlines. */
+		TickType_t xMaxExecutionTime;		/*< The longest execution time of any completed job. */
+		UBaseType_t uxBudgetOverruns;		/*< The number of jobs that ran for longer than xTaskWCET. */
+		uint8_t ucOverrunAction;			/*< The eBudgetOverrunAction taken when a job overruns xTaskWCET. */
+		uint8_t ucJobAborted;				/*< Set to pdTRUE once the kernel has abandoned the current job, until the next job is released.  The rest of the job only runs in the background. */
+		uint8_t ucSporadic;					/*< Set to pdTRUE for a task created with xTaskCreateSporadic_EDF(), whose jobs are released by xTaskReleaseJobFromISR_EDF() rather than by time.  xTaskPeriod holds the minimum inter-arrival time. */
+		UBaseType_t uxPendingReleases;		/*< The number of arrivals signalled to a sporadic task that have not yet released a job. */
+		TickType_t xPendingArrival;			/*< The time of the oldest of those arrivals. */
+
+		#if ( configUSE_EDF_LIMITED_PREEMPTION == 1 )
+			TickType_t xNonPreemptiveRegion;	/*< The number of ticks the task keeps running for after a job with an earlier deadline becomes ready.  0 if the task is fully preemptive. */
+		#endif
+		#if( configUSE_EDF_ADMISSION_CONTROL == 1 )
+			ListItem_t xAdmissionListItem;	/*< References the task from the list of tasks whose demand has been admitted. */
+		#endif
+
+		#if ( configUSE_EDF_ELASTIC_TASKS == 1 )
+			ListItem_t xElasticListItem;	/*< References the task from xElasticTasksListEDF. */
+			TickType_t xNominalPeriod;		/*< The period the task runs at while the utilisation target is met, which is also its shortest period. */
+			TickType_t xMaxPeriod;			/*< The longest period the elastic manager may stretch the task to. */
+			UBaseType_t uxElasticity;		/*< The elastic coefficient of the task.  The larger the coefficient the more of an overload the task absorbs.  0 if the period of the task is never stretched. */
+			uint8_t ucElasticFixed;			/*< Used by the elastic manager to mark a task whose period cannot be stretched further. */
+		#endif
+
+		#if ( configUSE_EDF_MK_FIRM == 1 )
+			UBaseType_t uxMKMeet;			/*< The m of the (m,k)-firm constraint of the task - the number of jobs in any uxMKWindow consecutive jobs that must meet their deadline. */
+			UBaseType_t uxMKWindow;			/*< The k of the (m,k)-firm constraint, at most 32, or 0 if the task has no such constraint and its jobs are never skipped. */
+			uint32_t ulMKHistory;			/*< One bit for each of the most recent jobs, set if the job met its deadline.  Bit 0 is the most recent job. */
+			UBaseType_t uxSkippedJobs;		/*< The number of jobs skipped to keep the task within its (m,k)-firm constraint. */
+		#endif
+	#endif
 
 } tskTCB;
 
@@ -354,6 +572,47 @@ typedef struct tskTaskControlBlock
 below to enable the use of older kernel aware debuggers. */
 typedef tskTCB TCB_t;
 
+#if( configUSE_EDF_SCHEDULER == 1 )
+
+	/* The members the scheduler reads on every decision must lie within the
+	first taskTCB_HOT_CACHE_LINES cache lines of a TCB that starts on a line,
+	the layout sched_bench measures.  Each member is checked here, so the build
+	fails if a member is added in front of them or one of them is moved out of
+	the group.  An array of negative size is used as there is no static
+	assertion in C89. */
+	#define taskCACHE_LINE_SIZE			( ( size_t ) 64U )
+	#define taskTCB_HOT_CACHE_LINES		( ( size_t ) 4U )
+	#define taskCHECK_HOT_TCB_MEMBER( xMember )																	\
+		typedef char prvHotTCBMemberCheck_##xMember[ ( ( offsetof( TCB_t, xMember ) + sizeof( ( ( TCB_t * ) 0 )->xMember ) ) <= ( taskCACHE_LINE_SIZE * taskTCB_HOT_CACHE_LINES ) ) ? 1 : -1 ]
+
+	taskCHECK_HOT_TCB_MEMBER( xStateHeapItem );
+	taskCHECK_HOT_TCB_MEMBER( xJobDeadline );
+	taskCHECK_HOT_TCB_MEMBER( xJobExecutionTime );
+	taskCHECK_HOT_TCB_MEMBER( xTaskWCET );
+	taskCHECK_HOT_TCB_MEMBER( xServerBudget );
+	taskCHECK_HOT_TCB_MEMBER( xRemainingBudget );
+	taskCHECK_HOT_TCB_MEMBER( xTaskPeriod );
+	taskCHECK_HOT_TCB_MEMBER( xStateListItem );
+	taskCHECK_HOT_TCB_MEMBER( xEventListItem );
+	taskCHECK_HOT_TCB_MEMBER( uxPriority );
+	taskCHECK_HOT_TCB_MEMBER( ucWaitingForRelease );
+	taskCHECK_HOT_TCB_MEMBER( ucJobOverrun );
+
+	#if( configGENERATE_RUN_TIME_STATS == 1 )
+		taskCHECK_HOT_TCB_MEMBER( ulRunTimeCounter );
+	#endif
+
+	#if ( configUSE_EDF_LIMITED_PREEMPTION == 1 )
+		taskCHECK_HOT_TCB_MEMBER( xNonPreemptiveTicksLeft );
+		taskCHECK_HOT_TCB_MEMBER( ucPreemptionDeferred );
+	#endif
+
+	#if ( configUSE_SRP_MUTEXES == 1 )
+		taskCHECK_HOT_TCB_MEMBER( ucJobStarted );
+	#endif
+
+#endif /* configUSE_EDF_SCHEDULER */
+
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
 
@@ -362,13 +621,50 @@ PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
 /* Lists for ready and blocked tasks. --------------------*/
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
 PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#if( configUSE_64_BIT_TICKS == 0 )
+	PRIVILEGED_DATA static List_t xDelayedTaskList2;					/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+	PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;	/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#endif
 PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if ( configUSE_EDF_SCHEDULER == 1 )
-	PRIVILEGED_DATA static List_t xReadyTasksListEDF;
+	#if ( configUSE_EDF_PRIORITY_BANDS == 1 )
+		PRIVILEGED_DATA static DeadlineHeap_t xReadyTasksHeapsEDF[ configMAX_PRIORITIES ];	/*< Ready tasks of each priority band ordered by deadline.  The head of the highest priority heap that is not empty is the task to run. */
+	#else
+		PRIVILEGED_DATA static DeadlineHeap_t xReadyTasksHeapEDF;		/*< Ready tasks ordered by deadline.  The head is the task to run. */
+	#endif
+	PRIVILEGED_DATA static DeadlineHeap_t xOutstandingJobsHeapEDF;		/*< Jobs that have been released but have neither completed nor missed their deadline, ordered by deadline. */
+	PRIVILEGED_DATA static List_t xWaitingForArrivalListEDF;			/*< Sporadic tasks that have completed their job and are blocked until the next job arrives. */
+	PRIVILEGED_DATA static volatile TickType_t xNextJobDeadline = portMAX_DELAY;	/*< The earliest deadline in xOutstandingJobsHeapEDF.  The tick only needs to compare against this value to detect a miss. */
+	PRIVILEGED_DATA static DeadlineHeap_t xReleaseHeapEDF1;				/*< Periodic and sporadic tasks blocked until their next job is released, ordered by release time.  Tasks blocked with a timeout stay in the delayed lists. */
+	PRIVILEGED_DATA static DeadlineHeap_t * volatile pxReleaseHeapEDF;	/*< Points to xReleaseHeapEDF1.  EDF requires a 64-bit tick count, so there is no overflow release heap. */
+	PRIVILEGED_DATA static volatile TickType_t xNextReleaseTimeEDF = portMAX_DELAY;	/*< The release time at the head of pxReleaseHeapEDF, as xNextTaskUnblockTime is for the delayed list. */
+#endif
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_SRP_MUTEXES == 1 ) )
+	/* The preemption level of a task is given by its relative deadline - the
+	shorter the deadline the higher the level.  The system ceiling is held in
+	the same units, so a job may only start if its relative deadline is shorter
+	than xSystemCeilingSRP. */
+	PRIVILEGED_DATA static DeadlineHeap_t xCeilingBlockedHeapSRP;		/*< Ready jobs that may not start until the system ceiling is lowered, ordered by deadline. */
+	PRIVILEGED_DATA static TickType_t xSystemCeilingSRP = portMAX_DELAY;	/*< The shortest ceiling of the SRP mutexes currently held, or portMAX_DELAY if none are held. */
+#endif
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_ADMISSION_CONTROL == 1 ) )
+	/* The admission test state is only accessed with the scheduler suspended.
+	The sums are updated as each task is admitted or deleted, so the
+	utilisation and density tests are O(1) and only a task that fails the
+	density test pays for the processor demand analysis. */
+	PRIVILEGED_DATA static List_t xAdmittedTasksListEDF;				/*< Tasks whose demand has been admitted.  Initialised on first use as the tasks lists are initialised after the first task is admitted. */
+	PRIVILEGED_DATA static uint64_t ullAdmittedUtilisationNumerator = 0ULL;		/*< The exact utilisation of the admitted tasks is ullAdmittedUtilisationNumerator / ullAdmittedUtilisationDenominator. */
+	PRIVILEGED_DATA static uint64_t ullAdmittedUtilisationDenominator = 1ULL;
+	PRIVILEGED_DATA static uint64_t ullAdmittedDensity = 0ULL;			/*< Sum of C / min( D, T ) in taskADMISSION_FIXED_POINT_ONE units, rounded up. */
+	PRIVILEGED_DATA static uint64_t ullAdmittedSlackDemand = 0ULL;		/*< Sum of ( T - D ) * C / T, rounded up, over the admitted tasks with D < T.  Used to bound the interval the processor demand analysis checks. */
+#endif /* configUSE_EDF_SCHEDULER && configUSE_EDF_ADMISSION_CONTROL */
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_ELASTIC_TASKS == 1 ) )
+	PRIVILEGED_DATA static List_t xElasticTasksListEDF;					/*< Every task created with timing parameters.  The elastic manager divides configEDF_ELASTIC_UTILISATION between them. */
 #endif
 
 #if( INCLUDE_vTaskDelete == 1 )
@@ -430,6 +726,18 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif
 
+#if( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_DEADLINE_MISS_HOOK > 0 ) )
+
+	extern void vApplicationDeadlineMissHook( TaskHandle_t xTask, TickType_t xDeadline );
+
+#endif
+
+#if( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_BUDGET_OVERRUN_HOOK > 0 ) )
+
+	extern void vApplicationBudgetOverrunHook( TaskHandle_t xTask, TickType_t xWCET );
+
+#endif
+
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
 
 	extern void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize );
@@ -455,6 +763,316 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
  */
 static void prvInitialiseTaskLists( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Remove a task from the ready heap or from the list its xStateListItem is
+ * referenced from, whichever it is in.  Used through taskREMOVE_FROM_STATE_LIST().
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static UBaseType_t prvRemoveTaskFromStateList( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Start a new job of an EDF task released at xReleaseTime, setting the absolute
+ * deadline of the job from the relative deadline of the task.  If the task is
+ * in the ready heap it is moved to its new position.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static void prvReleaseJob_EDF( TCB_t *pxTCB, TickType_t xReleaseTime ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by the running task after it has blocked waiting for its next
+	 * release.  If the task was unblocked before its release time (by
+	 * xTaskAbortDelay() or vTaskResume()) the tick did not release the job, so
+	 * it is released here at the time it was due.
+	 */
+	static void prvReleasePendingJob_EDF( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Block the running task in the release heap until xReleaseTime, at which
+	 * point the tick releases its next job.  Used in place of
+	 * prvAddCurrentTaskToDelayedList(), which keeps the delayed lists for tasks
+	 * that block with a timeout.
+	 */
+	static void prvAddCurrentTaskToReleaseHeap_EDF( const TickType_t xReleaseTime ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by the tick once xConstTickCount reaches xNextReleaseTimeEDF.
+	 * Releases every job that is due, taking the tasks from the head of the
+	 * release heap in one pass.  The tasks made ready are added to the batch
+	 * of the tick through prvEarliestReadiedTask_EDF(), starting from
+	 * pxEarliestTCB, and the result is returned.
+	 */
+	static TCB_t *prvReleaseDueJobs_EDF( const TickType_t xConstTickCount, TCB_t *pxEarliestTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Set xNextReleaseTimeEDF to the earliest release time in the release heap.
+	 */
+	static void prvResetNextReleaseTime_EDF( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called once the current job of the running task has completed or been
+	 * aborted.  The next job of a periodic task is released one period after
+	 * the previous release.  The next job of a sporadic task is released by
+	 * the oldest pending arrival, but no earlier than one minimum inter-arrival
+	 * time after the previous release.  The task is blocked until that release
+	 * time, or in xWaitingForArrivalListEDF if no arrival is pending.
+	 */
+	static void prvWaitForNextRelease_EDF( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Release the job of the oldest pending arrival of the sporadic task pxTCB,
+	 * at the time of the arrival or at xEarliestRelease if that is later.
+	 */
+	static void prvReleaseArrivedJob_EDF( TCB_t *pxTCB, TickType_t xEarliestRelease ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called when the current job of pxTCB completes at xCompletionTime.  A job
+	 * that already missed its deadline adds its lateness to the tardiness
+	 * statistics of the task.
+	 */
+	static void prvCompleteJob_EDF( TCB_t *pxTCB, TickType_t xCompletionTime ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Set xNextJobDeadline to the earliest deadline of any outstanding job.
+	 */
+	static void prvResetNextJobDeadline( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Apply the Constant Bandwidth Server wake-up rule to a CBS task that is
+	 * leaving the Blocked or Suspended state.  If the budget left cannot be
+	 * used by the current server deadline without exceeding the server
+	 * bandwidth Q / T, a new server deadline one period from now is set with a
+	 * full budget.
+	 */
+	static void prvWakeServer_CBS( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called from the tick when a CBS task has used up its budget.  The budget
+	 * is refilled and the server deadline postponed by one server period.
+	 */
+	static void prvReplenishServer_CBS( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called from the tick when the running job of a periodic task has
+	 * executed for longer than the WCET of the task.  Calls the overrun hook,
+	 * if configured, then takes the eBudgetOverrunAction set for the task.
+	 */
+	static void prvBudgetOverrun_EDF( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Abandon the current job of pxTCB.  The job can no longer miss its
+	 * deadline, and the task runs only when no job with a deadline is ready
+	 * until it calls vTaskWaitForNextJob_EDF(), which then waits for the job
+	 * after the abandoned one rather than completing it.
+	 */
+	static void prvAbortJob_EDF( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	#if ( configUSE_EDF_MK_FIRM == 1 )
+
+		/*
+		 * Returns pdTRUE if pxTCB has an (m,k)-firm constraint that still
+		 * holds if its current job does not meet its deadline.
+		 */
+		static BaseType_t prvJobCanBeSkipped_EDF( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+		/*
+		 * Returns pdTRUE if the job of the running task pxTCB cannot complete
+		 * within its WCET by its deadline, and can be skipped.
+		 */
+		static BaseType_t prvJobShouldBeSkipped_EDF( const TCB_t * const pxTCB, const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+		/*
+		 * Skip the current job of pxTCB.  The job is recorded as having missed
+		 * its deadline, but not counted as a deadline miss, and is abandoned as
+		 * by prvAbortJob_EDF(), so the rest of its budget is given to the
+		 * other jobs.
+		 */
+		static void prvSkipJob_EDF( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	#endif
+
+	/*
+	 * Returns pdTRUE if the job of pxTCB, which has just been made ready, has
+	 * an earlier deadline than the job of the running task and may start
+	 * under the Stack Resource Policy, if used.  If the running task has a
+	 * non-preemptive region that is not yet over, the region is started if
+	 * need be and pdFALSE is returned instead.
+	 */
+	static BaseType_t prvPreemptsCurrentTask_EDF( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Tasks made ready together - by one tick, or when the scheduler is
+	 * resumed - share one preemption decision.  Each task readied is passed to
+	 * prvEarliestReadiedTask_EDF() with the result of the previous call,
+	 * starting from NULL, and only the task returned by the last call is then
+	 * passed to prvPreemptsCurrentTask_EDF().  A task that could not start
+	 * under the SRP system ceiling is never returned, as it cannot preempt.
+	 */
+	static TCB_t *prvEarliestReadiedTask_EDF( TCB_t *pxEarliestTCB, TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return the ready heap whose head is the task to run next - the heap of
+	 * the highest priority band that contains a ready task if
+	 * configUSE_EDF_PRIORITY_BANDS is 1, otherwise the only ready heap.
+	 * Returns NULL if no task is ready.
+	 */
+	static DeadlineHeap_t *prvGetReadyHeapToRun_EDF( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return the task to run next - the head of the ready heap returned by
+	 * prvGetReadyHeapToRun_EDF(), or the idle task if no other task is ready.
+	 * The idle task is never in a ready heap, it runs in the background.
+	 */
+	static TCB_t *prvGetTaskToRun_EDF( void ) PRIVILEGED_FUNCTION;
+
+	#if ( configUSE_EDF_LIMITED_PREEMPTION == 1 )
+
+		/*
+		 * Called by vTaskSwitchContext() once pxEarliestTCB, the task with the
+		 * earliest deadline, has been found.  If pxRunningTCB is still ready
+		 * and has a non-preemptive region, the region is started, or continued,
+		 * and pxRunningTCB is returned so it keeps running.  Otherwise
+		 * pxEarliestTCB is returned.
+		 */
+		static TCB_t *prvLimitPreemption_EDF( TCB_t *pxRunningTCB, TCB_t *pxEarliestTCB ) PRIVILEGED_FUNCTION;
+
+	#endif /* configUSE_EDF_LIMITED_PREEMPTION */
+
+	#if ( configUSE_SRP_MUTEXES == 1 )
+
+		/*
+		 * Called before the head of the ready heap is selected to run.  Moves
+		 * each job at the head of the ready heap that has not started, and
+		 * whose preemption level is not above the system ceiling, to
+		 * xCeilingBlockedHeapSRP, until the head of the ready heap may run.
+		 * If every ready job is moved the ready heaps are left empty and the
+		 * idle task runs until the ceiling is lowered.
+		 */
+		static void prvApplySystemCeiling_SRP( void ) PRIVILEGED_FUNCTION;
+
+	#endif /* configUSE_SRP_MUTEXES */
+
+	#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+		/*
+		 * Creates the tasks for xTaskCreate_EDF(), xTaskCreateSporadic_EDF() and
+		 * xTaskCreate_CBS().
+		 */
+		static BaseType_t prvCreateTask_EDF( TaskFunction_t pxTaskCode, const char * const pcName, const configSTACK_DEPTH_TYPE usStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask, TickType_t xPeriod, TickType_t xDeadline, TickType_t xWCET, TickType_t xBudget, BaseType_t xSporadic ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+	#endif
+
+#endif
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	/*
+	 * Change the period of pxTCB, from its next release onwards.  A task whose
+	 * deadline is equal to its period keeps its deadline equal to its period.
+	 * If configUSE_EDF_ADMISSION_CONTROL is 1 the period is only changed if
+	 * the admitted tasks remain schedulable, otherwise pdFALSE is returned.
+	 * Must be called with the scheduler suspended.
+	 */
+	static BaseType_t prvSetPeriod_EDF( TCB_t *pxTCB, TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+
+	#if ( configUSE_EDF_ELASTIC_TASKS == 1 )
+
+		/*
+		 * The elastic manager.  If the total utilisation of the tasks at their
+		 * nominal periods exceeds configEDF_ELASTIC_UTILISATION, stretch the
+		 * periods of the elastic tasks, each in proportion to its elastic
+		 * coefficient, until it does not.  Otherwise return every task to its
+		 * nominal period.  Returns pdFALSE, leaving the periods not yet changed
+		 * as they were, as soon as admission control refuses a new period,
+		 * otherwise pdTRUE.  Must be called with the scheduler suspended.
+		 */
+		static BaseType_t prvCompressPeriods_EDF( void ) PRIVILEGED_FUNCTION;
+
+		#if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+
+			/*
+			 * Called when pxNewTCB, which is not yet initialised, failed
+			 * admission control.  Stretch the elastic tasks as if pxNewTCB had
+			 * been created, then try to admit it again.  If it still cannot be
+			 * admitted the elastic tasks are returned to their previous periods
+			 * and pdFALSE is returned.  Must be called with the scheduler
+			 * suspended.
+			 */
+			static BaseType_t prvAdmitByCompression_EDF( TCB_t *pxNewTCB, TickType_t xWCET, TickType_t xPeriod, TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+
+		#endif
+
+	#endif
+
+#endif
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_ADMISSION_CONTROL == 1 ) )
+
+	/*
+	 * Decide whether a task with worst case execution time xWCET, period
+	 * xPeriod and relative deadline xDeadline can be added to the admitted
+	 * tasks without any deadline being missed.  The task is rejected if the
+	 * utilisation would exceed one, admitted straight away if the density
+	 * would not exceed one, and otherwise admitted only if Quick
+	 * Processor-demand Analysis (QPA) finds no interval in which the demand
+	 * exceeds the processor time available.  Under rate or deadline monotonic
+	 * ordering the task is also rejected unless response time analysis shows
+	 * that it and every admitted task complete each job by its deadline.  If
+	 * the task is admitted its demand is added to the admission state and
+	 * pxTCB is added to xAdmittedTasksListEDF.  Must be called with the
+	 * scheduler suspended.
+	 */
+	static BaseType_t prvAdmitTask_EDF( TCB_t *pxTCB, TickType_t xWCET, TickType_t xPeriod, TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove the demand of a deleted task from the admission state.
+	 */
+	static void prvWithdrawTask_EDF( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The processor demand of the admitted tasks, plus the task being
+	 * admitted, over the interval [ 0, xTime ].
+	 */
+	static uint64_t prvProcessorDemand_EDF( uint64_t xTime, TickType_t xWCET, TickType_t xPeriod, TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The latest absolute deadline before xTime of any admitted task, or of
+	 * the task being admitted, with all tasks released together at time 0.
+	 * Returns 0 if there is no such deadline.
+	 */
+	static uint64_t prvLastDeadlineBefore_EDF( uint64_t xTime, TickType_t xPeriod, TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Euclid's algorithm, used to keep the exact utilisation fraction reduced.
+	 */
+	static uint64_t prvGreatestCommonDivisor( uint64_t ullA, uint64_t ullB ) PRIVILEGED_FUNCTION;
+
+	#if ( ( configEDF_SCHEDULING_POLICY == edfPOLICY_RM ) || ( configEDF_SCHEDULING_POLICY == edfPOLICY_DM ) )
+
+		/*
+		 * Response time analysis for the fixed orderings.  Returns pdTRUE if
+		 * the task being admitted, with WCET xWCET, period xPeriod and relative
+		 * deadline xDeadline, and every admitted task it can delay would each
+		 * complete every job by its deadline, otherwise pdFALSE.
+		 */
+		static BaseType_t prvResponseTimeTest_EDF( TickType_t xWCET, TickType_t xPeriod, TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+
+		/*
+		 * Returns pdTRUE if a job with execution time xWCET completes within
+		 * xDeadline of its release when it is released together with a job of
+		 * every other task whose ordering value is not greater than xKey.
+		 * pxTCB is the admitted task being analysed, or NULL for the task being
+		 * admitted, whose parameters are xNewWCET, xNewPeriod and xNewDeadline.
+		 */
+		static BaseType_t prvMeetsDeadline_EDF( const TCB_t * const pxTCB, TickType_t xWCET, TickType_t xKey, TickType_t xDeadline, TickType_t xNewWCET, TickType_t xNewPeriod, TickType_t xNewDeadline ) PRIVILEGED_FUNCTION;
+
+	#endif
+
+#endif /* configUSE_EDF_SCHEDULER && configUSE_EDF_ADMISSION_CONTROL */
+
 /*
  * The idle task, which as all tasks is implemented as a never ending loop.
  * The idle task is automatically created and added to the ready lists upon
@@ -840,31 +1458,109 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 							UBaseType_t uxPriority,
 							TaskHandle_t * const pxCreatedTask,
 							TickType_t period,
-							TickType_t deadline )
+							TickType_t deadline,
+							TickType_t wcet )
 	{
-	TCB_t *pxNewTCB;
-	BaseType_t xReturn;
-
-		/* If the stack grows down then allocate the stack then the TCB so the stack
-		does not grow into the TCB.  Likewise if the stack grows up then allocate
-		the TCB then the stack. */
-		#if( portSTACK_GROWTH > 0 )
+		/* A deadline of zero means the deadline is equal to the period. */
+		if( deadline == ( TickType_t ) 0 )
 		{
-			/* Allocate space for the TCB.  Where the memory comes from depends on
-			the implementation of the port malloc function and whether or not static
-			allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			deadline = period;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-			if( pxNewTCB != NULL )
-			{
-				/* Allocate space for the stack used by the task being created.
-				The base of the stack memory stored in the TCB so the task can
-				be deleted later if required. */
-				pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		return prvCreateTask_EDF( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, period, deadline, wcet, ( TickType_t ) 0U, pdFALSE );
+	}
+	/*-----------------------------------------------------------*/
 
-				if( pxNewTCB->pxStack == NULL )
-				{
-					/* Could not allocate the stack.  Delete the allocated TCB. */
+	BaseType_t xTaskCreateSporadic_EDF(	TaskFunction_t pxTaskCode,
+							const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+							const configSTACK_DEPTH_TYPE usStackDepth,
+							void * const pvParameters,
+							UBaseType_t uxPriority,
+							TaskHandle_t * const pxCreatedTask,
+							TickType_t interarrival,
+							TickType_t deadline,
+							TickType_t wcet )
+	{
+		configASSERT( interarrival > ( TickType_t ) 0U );
+
+		/* A deadline of zero means the deadline is equal to the minimum
+		inter-arrival time. */
+		if( deadline == ( TickType_t ) 0 )
+		{
+			deadline = interarrival;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Jobs arrive at most once every minimum inter-arrival time, so the
+		task places no more demand on the processor than a periodic task with
+		that period and is admitted as one. */
+		return prvCreateTask_EDF( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, interarrival, deadline, wcet, ( TickType_t ) 0U, pdTRUE );
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xTaskCreate_CBS(	TaskFunction_t pxTaskCode,
+							const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+							const configSTACK_DEPTH_TYPE usStackDepth,
+							void * const pvParameters,
+							UBaseType_t uxPriority,
+							TaskHandle_t * const pxCreatedTask,
+							TickType_t budget,
+							TickType_t period )
+	{
+		configASSERT( budget > ( TickType_t ) 0U );
+		configASSERT( budget <= period );
+
+		/* The server reserves a bandwidth of Q / T, which is the demand of a
+		periodic task with C = Q and D = T, so it is admitted as one. */
+		return prvCreateTask_EDF( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, period, period, budget, budget, pdFALSE );
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvCreateTask_EDF( TaskFunction_t pxTaskCode,
+							const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+							const configSTACK_DEPTH_TYPE usStackDepth,
+							void * const pvParameters,
+							UBaseType_t uxPriority,
+							TaskHandle_t * const pxCreatedTask,
+							TickType_t xPeriod,
+							TickType_t xDeadline,
+							TickType_t xWCET,
+							TickType_t xBudget,
+							BaseType_t xSporadic )
+	{
+	TCB_t *pxNewTCB;
+	BaseType_t xReturn;
+	#if( configUSE_EDF_ADMISSION_CONTROL == 1 )
+		BaseType_t xAdmitted;
+	#endif
+
+		/* If the stack grows down then allocate the stack then the TCB so the stack
+		does not grow into the TCB.  Likewise if the stack grows up then allocate
+		the TCB then the stack. */
+		#if( portSTACK_GROWTH > 0 )
+		{
+			/* Allocate space for the TCB.  Where the memory comes from depends on
+			the implementation of the port malloc function and whether or not static
+			allocation is being used. */
+			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+
+			if( pxNewTCB != NULL )
+			{
+				/* Allocate space for the stack used by the task being created.
+				The base of the stack memory stored in the TCB so the task can
+				be deleted later if required. */
+				pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+				if( pxNewTCB->pxStack == NULL )
+				{
+					/* Could not allocate the stack.  Delete the allocated TCB. */
 					vPortFree( pxNewTCB );
 					pxNewTCB = NULL;
 				}
@@ -911,21 +1607,94 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			}
 			#endif /* configSUPPORT_STATIC_ALLOCATION */
 
-			pxNewTCB->xTaskPeriod = period; //changes vs xTaskCreate
-			pxNewTCB->xTaskDeadline = deadline;
+			/* The task is initialised before it is admitted, so its list items
+			are valid whether or not the admission test places it in the
+			admitted tasks list. */
 			prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
-			TickType_t xTicks;
 
-			/* Critical section required if running on a 16 bit processor. */
-			portTICK_TYPE_ENTER_CRITICAL();
+			#if( configUSE_EDF_ADMISSION_CONTROL == 1 )
+			{
+				/* The scheduler remains suspended until the timing parameters
+				of the task have been set, so no other task is admitted
+				against a partially created task. */
+				vTaskSuspendAll();
+
+				xAdmitted = prvAdmitTask_EDF( pxNewTCB, xWCET, xPeriod, xDeadline );
+
+				#if( configUSE_EDF_ELASTIC_TASKS == 1 )
+				{
+					/* The elastic tasks may be able to make room for the new
+					task. */
+					if( xAdmitted == pdFALSE )
+					{
+						xAdmitted = prvAdmitByCompression_EDF( pxNewTCB, xWCET, xPeriod, xDeadline );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_EDF_ELASTIC_TASKS */
+
+				if( xAdmitted == pdFALSE )
+				{
+					( void ) xTaskResumeAll();
+
+					/* The task has not been added to any list, so its memory
+					can simply be freed.  The handle written by
+					prvInitialiseNewTask() no longer refers to a task. */
+					if( ( void * ) pxCreatedTask != NULL )
+					{
+						*pxCreatedTask = NULL;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					vPortFree( pxNewTCB->pxStack );
+					vPortFree( pxNewTCB );
+
+					return errTASK_NOT_SCHEDULABLE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_EDF_ADMISSION_CONTROL */
+
+			pxNewTCB->xTaskPeriod = xPeriod;
+			pxNewTCB->xTaskDeadline = xDeadline;
+			pxNewTCB->xTaskWCET = xWCET;
+			pxNewTCB->xServerBudget = xBudget;
+			pxNewTCB->ucSporadic = ( uint8_t ) xSporadic;
+
+			#if( configUSE_EDF_ADMISSION_CONTROL == 1 )
 			{
-				xTicks = xTickCount;
+				( void ) xTaskResumeAll();
 			}
-			portTICK_TYPE_EXIT_CRITICAL();
-			listSET_LIST_ITEM_VALUE(&( ( pxNewTCB )->xStateListItem ), ( pxNewTCB)->xTaskPeriod + xTicks);
-			
+			#endif /* configUSE_EDF_ADMISSION_CONTROL */
 
+			/* The first job is released, or the first server deadline set, as
+			the task is added to the ready heap. */
 			prvAddNewTaskToReadyList( pxNewTCB );
+
+			#if( configUSE_EDF_ELASTIC_TASKS == 1 )
+			{
+				/* The task is created rigid.  Its utilisation may still
+				require the elastic tasks to be stretched. */
+				vTaskSuspendAll();
+				{
+					pxNewTCB->xNominalPeriod = xPeriod;
+					pxNewTCB->xMaxPeriod = xPeriod;
+					vListInsertEnd( &xElasticTasksListEDF, &( pxNewTCB->xElasticListItem ) );
+					( void ) prvCompressPeriods_EDF();
+				}
+				( void ) xTaskResumeAll();
+			}
+			#endif /* configUSE_EDF_ELASTIC_TASKS */
+
 			xReturn = pdPASS;
 		}
 		else
@@ -1054,6 +1823,84 @@ UBaseType_t x;
 	back to	the containing TCB from a generic item in a list. */
 	listSET_LIST_ITEM_OWNER( &( pxNewTCB->xStateListItem ), pxNewTCB );
 
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+	{
+		vDeadlineHeapInitialiseItem( &( pxNewTCB->xStateHeapItem ) );
+		heapSET_HEAP_ITEM_OWNER( &( pxNewTCB->xStateHeapItem ), pxNewTCB );
+
+		/* Tasks not created with xTaskCreate_EDF() have no timing parameters.
+		Their deadline is left at zero so they are ordered ahead of every EDF
+		job, which keeps kernel tasks such as the timer service responsive. */
+		pxNewTCB->xTaskPeriod = ( TickType_t ) 0U;
+		pxNewTCB->xTaskDeadline = ( TickType_t ) 0U;
+		pxNewTCB->xJobRelease = ( TickType_t ) 0U;
+		pxNewTCB->xJobDeadline = ( TickType_t ) 0U;
+		pxNewTCB->uxJobNumber = ( UBaseType_t ) 0U;
+		pxNewTCB->ucWaitingForRelease = pdFALSE;
+
+		vDeadlineHeapInitialiseItem( &( pxNewTCB->xDeadlineHeapItem ) );
+		heapSET_HEAP_ITEM_OWNER( &( pxNewTCB->xDeadlineHeapItem ), pxNewTCB );
+		pxNewTCB->uxDeadlineMisses = ( UBaseType_t ) 0U;
+		pxNewTCB->xMaxLateness = ( TickType_t ) 0U;
+		pxNewTCB->xTotalTardiness = ( TickType_t ) 0U;
+		pxNewTCB->xTaskWCET = ( TickType_t ) 0U;
+		pxNewTCB->xServerBudget = ( TickType_t ) 0U;
+		pxNewTCB->xRemainingBudget = ( TickType_t ) 0U;
+		pxNewTCB->xJobExecutionTime = ( TickType_t ) 0U;
+		pxNewTCB->xMaxExecutionTime = ( TickType_t ) 0U;
+		pxNewTCB->uxBudgetOverruns = ( UBaseType_t ) 0U;
+		pxNewTCB->ucJobOverrun = pdFALSE;
+		pxNewTCB->ucOverrunAction = ( uint8_t ) eOverrunNotify;
+		pxNewTCB->ucJobAborted = pdFALSE;
+		pxNewTCB->ucSporadic = pdFALSE;
+		pxNewTCB->uxPendingReleases = ( UBaseType_t ) 0U;
+		pxNewTCB->xPendingArrival = ( TickType_t ) 0U;
+
+		#if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+		{
+			/* Every task is initialised here, whatever function created it, so
+			vTaskDelete() can test whether the task was admitted. */
+			vListInitialiseItem( &( pxNewTCB->xAdmissionListItem ) );
+			listSET_LIST_ITEM_OWNER( &( pxNewTCB->xAdmissionListItem ), pxNewTCB );
+		}
+		#endif
+
+		#if ( configUSE_EDF_ELASTIC_TASKS == 1 )
+		{
+			vListInitialiseItem( &( pxNewTCB->xElasticListItem ) );
+			listSET_LIST_ITEM_OWNER( &( pxNewTCB->xElasticListItem ), pxNewTCB );
+			pxNewTCB->xNominalPeriod = ( TickType_t ) 0U;
+			pxNewTCB->xMaxPeriod = ( TickType_t ) 0U;
+			pxNewTCB->uxElasticity = ( UBaseType_t ) 0U;
+			pxNewTCB->ucElasticFixed = pdFALSE;
+		}
+		#endif
+
+		#if ( configUSE_EDF_MK_FIRM == 1 )
+		{
+			pxNewTCB->uxMKMeet = ( UBaseType_t ) 0U;
+			pxNewTCB->uxMKWindow = ( UBaseType_t ) 0U;
+			pxNewTCB->ulMKHistory = ~( ( uint32_t ) 0U );
+			pxNewTCB->uxSkippedJobs = ( UBaseType_t ) 0U;
+		}
+		#endif
+
+		#if ( configUSE_SRP_MUTEXES == 1 )
+		{
+			pxNewTCB->ucJobStarted = pdFALSE;
+		}
+		#endif
+
+		#if ( configUSE_EDF_LIMITED_PREEMPTION == 1 )
+		{
+			pxNewTCB->xNonPreemptiveRegion = ( TickType_t ) 0U;
+			pxNewTCB->xNonPreemptiveTicksLeft = ( TickType_t ) 0U;
+			pxNewTCB->ucPreemptionDeferred = pdFALSE;
+		}
+		#endif
+	}
+	#endif /* configUSE_EDF_SCHEDULER */
+
 	/* Event lists are always in priority order. */
 	listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 	listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
@@ -1173,21 +2020,25 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			/* If the scheduler is not already running, make this task the
 			current task if it is the highest priority task to be created
 			so far. */
-			if( xSchedulerRunning == pdFALSE )
+			#if ( configUSE_EDF_SCHEDULER == 0 )
 			{
-				if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+				if( xSchedulerRunning == pdFALSE )
 				{
-					pxCurrentTCB = pxNewTCB;
+					if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+					{
+						pxCurrentTCB = pxNewTCB;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
 				else
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
+			#endif /* configUSE_EDF_SCHEDULER */
 		}
 
 		uxTaskNumber++;
@@ -1200,7 +2051,38 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		#endif /* configUSE_TRACE_FACILITY */
 		traceTASK_CREATE( pxNewTCB );
 
-		prvAddTaskToReadyList( pxNewTCB );
+		#if ( configUSE_EDF_SCHEDULER == 1 )
+		{
+			/* Release the first job of a periodic task now the task lists are
+			known to be initialised, so its deadline is set before it is keyed
+			into the ready heap. */
+			if( taskIS_PERIODIC_EDF( pxNewTCB ) )
+			{
+				prvReleaseJob_EDF( pxNewTCB, xTickCount );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_EDF_SCHEDULER */
+
+		prvAddUnblockedTaskToReadyList( pxNewTCB );
+
+		#if ( configUSE_EDF_SCHEDULER == 1 )
+		{
+			/* The task with the earliest deadline of those created so far is
+			the one that runs when the scheduler is started. */
+			if( xSchedulerRunning == pdFALSE )
+			{
+				pxCurrentTCB = prvGetTaskToRun_EDF();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_EDF_SCHEDULER */
 
 		portSETUP_TCB( pxNewTCB );
 	}
@@ -1210,7 +2092,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	{
 		/* If the created task is of a higher priority than the current task
 		then it should run now. */
-		if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+		if( taskHAS_PRIORITY_OVER_CURRENT( pxNewTCB ) )
 		{
 			taskYIELD_IF_USING_PREEMPTION();
 		}
@@ -1231,6 +2113,9 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	void vTaskDelete( TaskHandle_t xTaskToDelete )
 	{
 	TCB_t *pxTCB;
+	#if( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_ELASTIC_TASKS == 1 ) )
+		BaseType_t xWasElastic = pdFALSE;
+	#endif
 
 		taskENTER_CRITICAL();
 		{
@@ -1239,7 +2124,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			pxTCB = prvGetTCBFromHandle( xTaskToDelete );
 
 			/* Remove task from the ready list. */
-			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			if( taskREMOVE_FROM_STATE_LIST( pxTCB ) == ( UBaseType_t ) 0 )
 			{
 				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 			}
@@ -1258,6 +2143,51 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 
+			#if ( configUSE_EDF_SCHEDULER == 1 )
+			{
+				/* A deleted task cannot miss the deadline of its current job. */
+				if( heapHEAP_ITEM_CONTAINER( &( pxTCB->xDeadlineHeapItem ) ) != NULL )
+				{
+					( void ) uxDeadlineHeapRemove( &( pxTCB->xDeadlineHeapItem ) );
+					prvResetNextJobDeadline();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				#if( configUSE_EDF_ADMISSION_CONTROL == 1 )
+				{
+					/* Free the bandwidth of the task for tasks admitted later. */
+					if( listLIST_ITEM_CONTAINER( &( pxTCB->xAdmissionListItem ) ) != NULL )
+					{
+						prvWithdrawTask_EDF( pxTCB );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_EDF_ADMISSION_CONTROL */
+
+				#if( configUSE_EDF_ELASTIC_TASKS == 1 )
+				{
+					/* The periods of the other tasks are recomputed once the
+					critical section has been left. */
+					if( listLIST_ITEM_CONTAINER( &( pxTCB->xElasticListItem ) ) != NULL )
+					{
+						( void ) uxListRemove( &( pxTCB->xElasticListItem ) );
+						xWasElastic = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_EDF_ELASTIC_TASKS */
+			}
+			#endif /* configUSE_EDF_SCHEDULER */
+
 			/* Increment the uxTaskNumber also so kernel aware debuggers can
 			detect that the task lists need re-generating.  This is done before
 			portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -1299,6 +2229,26 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		}
 		taskEXIT_CRITICAL();
 
+		#if( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_ELASTIC_TASKS == 1 ) )
+		{
+			/* The utilisation freed by the deleted task lets the elastic tasks
+			shrink back towards their nominal periods.  A period the manager
+			cannot change leaves the task at its current, admitted period. */
+			if( xWasElastic != pdFALSE )
+			{
+				vTaskSuspendAll();
+				{
+					( void ) prvCompressPeriods_EDF();
+				}
+				( void ) xTaskResumeAll();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_EDF_SCHEDULER && configUSE_EDF_ELASTIC_TASKS */
+
 		/* Force a reschedule if it is the currently running task that has just
 		been deleted. */
 		if( xSchedulerRunning != pdFALSE )
@@ -1335,6 +2285,19 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			block. */
 			const TickType_t xConstTickCount = xTickCount;
 
+			#if ( configUSE_EDF_SCHEDULER == 1 )
+			{
+				if( taskIS_PERIODIC_EDF( pxCurrentTCB ) )
+				{
+					prvCompleteJob_EDF( pxCurrentTCB, xConstTickCount );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_EDF_SCHEDULER */
+
 			/* Generate the tick time at which the task wants to wake. */
 			xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
 
@@ -1376,13 +2339,39 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			{
 				traceTASK_DELAY_UNTIL( xTimeToWake );
 
-				/* prvAddCurrentTaskToDelayedList() needs the block time, not
-				the time to wake, so subtract the current tick count. */
-				prvAddCurrentTaskToDelayedList( xTimeToWake - xConstTickCount, pdFALSE );
+				#if ( configUSE_EDF_SCHEDULER == 1 )
+				/* An EDF task ends its job by delaying until its next
+				release.  The job is released by the tick that unblocks the
+				task. */
+				if( taskIS_PERIODIC_EDF( pxCurrentTCB ) )
+				{
+					prvAddCurrentTaskToReleaseHeap_EDF( xTimeToWake );
+				}
+				else
+				#endif /* configUSE_EDF_SCHEDULER */
+				{
+					/* prvAddCurrentTaskToDelayedList() needs the block time,
+					not the time to wake, so subtract the current tick
+					count. */
+					prvAddCurrentTaskToDelayedList( xTimeToWake - xConstTickCount, pdFALSE );
+				}
 			}
 			else
 			{
-				mtCOVERAGE_TEST_MARKER();
+				#if ( configUSE_EDF_SCHEDULER == 1 )
+				{
+					/* The wake time has already passed, so the next job is
+					released immediately. */
+					if( taskIS_PERIODIC_EDF( pxCurrentTCB ) )
+					{
+						prvReleaseJob_EDF( pxCurrentTCB, xTimeToWake );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_EDF_SCHEDULER */
 			}
 		}
 		xAlreadyYielded = xTaskResumeAll();
@@ -1397,40 +2386,40 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+
+		#if ( configUSE_EDF_SCHEDULER == 1 )
+		{
+			prvReleasePendingJob_EDF();
+		}
+		#endif /* configUSE_EDF_SCHEDULER */
 	}
 
 #endif /* INCLUDE_vTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelay == 1 )
+#if ( configUSE_EDF_SCHEDULER == 1 )
 
-	void vTaskDelay( const TickType_t xTicksToDelay )
+	void vTaskWaitForNextJob_EDF( void )
 	{
-	BaseType_t xAlreadyYielded = pdFALSE;
-
-		/* A delay time of zero just forces a reschedule. */
-		if( xTicksToDelay > ( TickType_t ) 0U )
-		{
-			configASSERT( uxSchedulerSuspended == 0 );
-			vTaskSuspendAll();
-			{
-				traceTASK_DELAY();
+	BaseType_t xAlreadyYielded;
 
-				/* A task that is removed from the event list while the
-				scheduler is suspended will not get placed in the ready
-				list or removed from the blocked list until the scheduler
-				is resumed.
+		configASSERT( taskIS_PERIODIC_EDF( pxCurrentTCB ) );
+		configASSERT( uxSchedulerSuspended == 0 );
 
-				This task cannot be in an event list as it is the currently
-				executing task. */
-				prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
-			}
-			xAlreadyYielded = xTaskResumeAll();
-		}
-		else
+		vTaskSuspendAll();
 		{
-			mtCOVERAGE_TEST_MARKER();
+			/* Minor optimisation.  The tick count cannot change in this
+			block. */
+			const TickType_t xConstTickCount = xTickCount;
+
+			/* A job abandoned by the kernel was recorded when it was
+			abandoned.  The next release is still measured from its release,
+			so the job after it is waited for, or released straight away if it
+			is already due, rather than being completed unrun. */
+			prvCompleteJob_EDF( pxCurrentTCB, xConstTickCount );
+			prvWaitForNextRelease_EDF( xConstTickCount );
 		}
+		xAlreadyYielded = xTaskResumeAll();
 
 		/* Force a reschedule if xTaskResumeAll has not already done so, we may
 		have put ourselves to sleep. */
@@ -1442,12 +2431,368 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+
+		prvReleasePendingJob_EDF();
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* INCLUDE_vTaskDelay */
-/*-----------------------------------------------------------*/
+	BaseType_t xTaskReleaseJobFromISR_EDF( TaskHandle_t xTask, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	TCB_t * const pxTCB = ( TCB_t * ) xTask;
+	BaseType_t xReturn = pdFALSE;
+	UBaseType_t uxSavedInterruptStatus;
 
-#if( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) )
+		configASSERT( pxTCB );
+		configASSERT( pxTCB->ucSporadic != pdFALSE );
+
+		/* See the comments in xTaskResumeFromISR(). */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			const TickType_t xConstTickCount = xTickCount;
+
+			traceTASK_RELEASE_JOB_FROM_ISR( pxTCB );
+
+			if( pxTCB->uxPendingReleases == ( UBaseType_t ) 0U )
+			{
+				pxTCB->xPendingArrival = xConstTickCount;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			( pxTCB->uxPendingReleases )++;
+
+			/* A task in xWaitingForArrivalListEDF has completed its previous
+			job at least one minimum inter-arrival time ago, so the job is
+			released now.  Otherwise the arrival stays pending until the
+			current job completes or the minimum inter-arrival time has
+			passed.  A task whose event list item is in the pending ready list
+			has already been released by an earlier arrival. */
+			if( ( listIS_CONTAINED_WITHIN( &xWaitingForArrivalListEDF, &( pxTCB->xStateListItem ) ) != pdFALSE ) &&
+				( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL ) )
+			{
+				prvReleaseArrivedJob_EDF( pxTCB, xConstTickCount );
+
+				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+				{
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					prvAddUnblockedTaskToReadyList( pxTCB );
+				}
+				else
+				{
+					/* The delayed and ready lists cannot be accessed, so hold
+					this task pending until the scheduler is resumed. */
+					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+				}
+
+				if( taskHAS_PRIORITY_OVER_CURRENT( pxTCB ) )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* Mark that a yield is pending in case the user is not
+					using the "xHigherPriorityTaskWoken" parameter. */
+					xYieldPending = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	void vTaskSetOverrunAction_EDF( TaskHandle_t xTask, eBudgetOverrunAction eAction )
+	{
+	TCB_t *pxTCB;
+
+		/* If null is passed in here then the action of the calling task is
+		being set. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB->ucOverrunAction = ( uint8_t ) eAction;
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xTaskIsJobAborted_EDF( void )
+	{
+		/* Only the calling task is queried, and the flag is only changed by
+		the tick or when the next job is released, so no critical section is
+		needed to read a single byte. */
+		return ( pxCurrentTCB->ucJobAborted != pdFALSE ) ? pdTRUE : pdFALSE;
+	}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_MK_FIRM == 1 ) )
+
+	void vTaskSetMKFirm_EDF( TaskHandle_t xTask, UBaseType_t uxM, UBaseType_t uxK )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( uxK <= ( UBaseType_t ) 32U );
+		configASSERT( uxM <= uxK );
+
+		/* If null is passed in here then the constraint of the calling task
+		is being set. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+		configASSERT( taskIS_PERIODIC_EDF( pxTCB ) );
+
+		taskENTER_CRITICAL();
+		{
+			/* The jobs before the constraint was set are taken to have met
+			their deadlines. */
+			pxTCB->uxMKMeet = uxM;
+			pxTCB->uxMKWindow = uxK;
+			pxTCB->ulMKHistory = ~( ( uint32_t ) 0U );
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_EDF_SCHEDULER && configUSE_EDF_MK_FIRM */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_LIMITED_PREEMPTION == 1 ) )
+
+	void vTaskSetNonPreemptiveRegion_EDF( TaskHandle_t xTask, TickType_t xRegion )
+	{
+	TCB_t *pxTCB;
+
+		/* If null is passed in here then the region of the calling task is
+		being set. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB->xNonPreemptiveRegion = xRegion;
+
+			/* A region that is already running is not lengthened. */
+			if( pxTCB->xNonPreemptiveTicksLeft > xRegion )
+			{
+				pxTCB->xNonPreemptiveTicksLeft = xRegion;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_EDF_SCHEDULER && configUSE_EDF_LIMITED_PREEMPTION */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	BaseType_t xTaskSetPeriod_EDF( TaskHandle_t xTask, TickType_t xPeriod )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xReturn;
+	#if ( configUSE_EDF_ELASTIC_TASKS == 1 )
+		TickType_t xOldNominalPeriod, xOldMaxPeriod;
+	#endif
+
+		configASSERT( xPeriod > ( TickType_t ) 0U );
+
+		/* If null is passed in here then the period of the calling task is
+		being set. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+		configASSERT( pxTCB->xTaskPeriod != ( TickType_t ) 0U );
+
+		vTaskSuspendAll();
+		{
+			#if ( configUSE_EDF_ELASTIC_TASKS == 1 )
+			{
+				/* The new period is the nominal period of the task, which is
+				stretched again if the utilisation target is exceeded.  The
+				manager is run as a trial - if admission control refuses any of
+				the periods it computes, the old parameters are restored and
+				the manager run again to return the tasks to the periods it
+				computes for them. */
+				xOldNominalPeriod = pxTCB->xNominalPeriod;
+				xOldMaxPeriod = pxTCB->xMaxPeriod;
+				pxTCB->xNominalPeriod = xPeriod;
+
+				if( pxTCB->xMaxPeriod < xPeriod )
+				{
+					pxTCB->xMaxPeriod = xPeriod;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( prvCompressPeriods_EDF() != pdFALSE )
+				{
+					xReturn = pdPASS;
+				}
+				else
+				{
+					pxTCB->xNominalPeriod = xOldNominalPeriod;
+					pxTCB->xMaxPeriod = xOldMaxPeriod;
+					( void ) prvCompressPeriods_EDF();
+					xReturn = pdFAIL;
+				}
+			}
+			#else
+			{
+				xReturn = prvSetPeriod_EDF( pxTCB, xPeriod );
+			}
+			#endif /* configUSE_EDF_ELASTIC_TASKS */
+		}
+		( void ) xTaskResumeAll();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_ELASTIC_TASKS == 1 ) )
+
+	void vTaskSetElasticity_EDF( TaskHandle_t xTask, TickType_t xMinPeriod, TickType_t xMaxPeriod, UBaseType_t uxElasticity )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( xMinPeriod > ( TickType_t ) 0U );
+		configASSERT( xMinPeriod <= xMaxPeriod );
+
+		/* If null is passed in here then the calling task is being made
+		elastic. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+		configASSERT( pxTCB->xTaskPeriod != ( TickType_t ) 0U );
+
+		vTaskSuspendAll();
+		{
+			pxTCB->xNominalPeriod = xMinPeriod;
+			pxTCB->xMaxPeriod = xMaxPeriod;
+			pxTCB->uxElasticity = uxElasticity;
+
+			/* A period the manager cannot change leaves the task at its
+			current, admitted period. */
+			( void ) prvCompressPeriods_EDF();
+		}
+		( void ) xTaskResumeAll();
+	}
+
+#endif /* configUSE_EDF_SCHEDULER && configUSE_EDF_ELASTIC_TASKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	void vTaskGetJobStatus_EDF( TaskHandle_t xTask, TaskJobStatus_t *pxJobStatus )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( pxJobStatus );
+
+		/* If null is passed in here then the status of the calling task is
+		being queried. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		taskENTER_CRITICAL();
+		{
+			pxJobStatus->uxJobNumber = pxTCB->uxJobNumber;
+			pxJobStatus->xRelease = pxTCB->xJobRelease;
+			pxJobStatus->xDeadline = pxTCB->xJobDeadline;
+			pxJobStatus->uxDeadlineMisses = pxTCB->uxDeadlineMisses;
+			pxJobStatus->xMaxLateness = pxTCB->xMaxLateness;
+			pxJobStatus->xTotalTardiness = pxTCB->xTotalTardiness;
+			pxJobStatus->xExecutionTime = pxTCB->xJobExecutionTime;
+			pxJobStatus->xMaxExecutionTime = pxTCB->xMaxExecutionTime;
+			pxJobStatus->uxBudgetOverruns = pxTCB->uxBudgetOverruns;
+			pxJobStatus->xPeriod = pxTCB->xTaskPeriod;
+
+			#if ( configUSE_EDF_MK_FIRM == 1 )
+			{
+				pxJobStatus->uxSkippedJobs = pxTCB->uxSkippedJobs;
+			}
+			#else
+			{
+				pxJobStatus->uxSkippedJobs = ( UBaseType_t ) 0U;
+			}
+			#endif
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelay == 1 )
+
+	void vTaskDelay( const TickType_t xTicksToDelay )
+	{
+	BaseType_t xAlreadyYielded = pdFALSE;
+
+		/* A delay time of zero just forces a reschedule. */
+		if( xTicksToDelay > ( TickType_t ) 0U )
+		{
+			configASSERT( uxSchedulerSuspended == 0 );
+			vTaskSuspendAll();
+			{
+				traceTASK_DELAY();
+
+				/* A task that is removed from the event list while the
+				scheduler is suspended will not get placed in the ready
+				list or removed from the blocked list until the scheduler
+				is resumed.
+
+				This task cannot be in an event list as it is the currently
+				executing task. */
+				prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
+			}
+			xAlreadyYielded = xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Force a reschedule if xTaskResumeAll has not already done so, we may
+		have put ourselves to sleep. */
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* INCLUDE_vTaskDelay */
+/*-----------------------------------------------------------*/
+
+#if( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) )
 
 	eTaskState eTaskGetState( TaskHandle_t xTask )
 	{
@@ -1470,7 +2815,11 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			}
 			taskEXIT_CRITICAL();
 
+			#if( configUSE_64_BIT_TICKS == 0 )
 			if( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) )
+			#else
+			if( pxStateList == pxDelayedTaskList )
+			#endif
 			{
 				/* The task being queried is referenced from one of the Blocked
 				lists. */
@@ -1494,6 +2843,33 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				}
 			#endif
 
+			#if ( configUSE_EDF_SCHEDULER == 1 )
+				else if( taskIS_WAITING_FOR_RELEASE_EDF( pxTCB ) )
+				{
+					/* The task is blocked until its next job is released. */
+					eReturn = eBlocked;
+				}
+				else if( heapHEAP_ITEM_CONTAINER( &( pxTCB->xStateHeapItem ) ) != NULL )
+				{
+					/* The task is referenced from the ready heap, or from
+					xCeilingBlockedHeapSRP if its job is held back by the SRP
+					system ceiling, so its xStateListItem is not in any
+					list. */
+					eReturn = eReady;
+				}
+				else if( pxTCB == ( TCB_t * ) xIdleTaskHandle )
+				{
+					/* The idle task is not referenced from any list or heap,
+					but it is always ready to run. */
+					eReturn = eReady;
+				}
+				else if( ( pxStateList == &xWaitingForArrivalListEDF ) && ( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL ) )
+				{
+					/* A sporadic task waiting for its next job to arrive. */
+					eReturn = eBlocked;
+				}
+			#endif
+
 			#if ( INCLUDE_vTaskDelete == 1 )
 				else if( ( pxStateList == &xTasksWaitingTermination ) || ( pxStateList == NULL ) )
 				{
@@ -1701,12 +3077,12 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				nothing more than change its priority variable. However, if
 				the task is in a ready list it needs to be removed and placed
 				in the list appropriate to its new priority. */
-				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+				if( taskIS_IN_READY_LIST( pxTCB, uxPriorityUsedOnEntry ) != pdFALSE )
 				{
 					/* The task is currently in its ready list - remove before
 					adding it to it's new ready list.  As we are in a critical
 					section we can do this even if the scheduler is suspended. */
-					if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+					if( taskREMOVE_FROM_STATE_LIST( pxTCB ) == ( UBaseType_t ) 0 )
 					{
 						/* It is known that the task is in its ready list so
 						there is no need to check again and the port level
@@ -1760,7 +3136,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			/* Remove task from the ready/delayed list and place in the
 			suspended list. */
-			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			if( taskREMOVE_FROM_STATE_LIST( pxTCB ) == ( UBaseType_t ) 0 )
 			{
 				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 			}
@@ -1913,10 +3289,10 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					/* The ready list can be accessed even if the scheduler is
 					suspended because this is inside a critical section. */
 					( void ) uxListRemove(  &( pxTCB->xStateListItem ) );
-					prvAddTaskToReadyList( pxTCB );
+					prvAddUnblockedTaskToReadyList( pxTCB );
 
 					/* A higher priority task may have just been resumed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskHAS_PRIORITY_OF_CURRENT_OR_ABOVE( pxTCB ) )
 					{
 						/* This yield may not cause the task just resumed to run,
 						but will leave the lists in the correct state for the
@@ -1984,7 +3360,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				{
 					/* Ready lists can be accessed so move the task from the
 					suspended list to the ready list directly. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskHAS_PRIORITY_OF_CURRENT_OR_ABOVE( pxTCB ) )
 					{
 						xYieldRequired = pdTRUE;
 					}
@@ -1994,7 +3370,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					}
 
 					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-					prvAddTaskToReadyList( pxTCB );
+					prvAddUnblockedTaskToReadyList( pxTCB );
 				}
 				else
 				{
@@ -2051,26 +3427,42 @@ BaseType_t xReturn;
 	#else
 	{
 		/* The Idle task is being created using dynamically allocated RAM. */
-		#if(configUSE_EDF_SCHEDULER == 1)
-			TickType_t initIDLEPeriod = 90000;
-			xReturn = xTaskCreate_EDF(	prvIdleTask,
-								configIDLE_TASK_NAME,
-								configMINIMAL_STACK_SIZE,
-								( void * ) NULL,
-								( tskIDLE_PRIORITY | portPRIVILEGE_BIT ),
-								NULL, initIDLEPeriod, 0);
-
-		#else
 		xReturn = xTaskCreate(	prvIdleTask,
 								configIDLE_TASK_NAME,
 								configMINIMAL_STACK_SIZE,
 								( void * ) NULL,
 								( tskIDLE_PRIORITY | portPRIVILEGE_BIT ),
 								&xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
-		#endif						
 	}
 	#endif /* configSUPPORT_STATIC_ALLOCATION */
 
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+	{
+		if( xReturn == pdPASS )
+		{
+		TCB_t * const pxIdleTCB = ( TCB_t * ) xIdleTaskHandle;
+
+			/* The idle task has no deadline to order it by, so rather than
+			giving it a period it is taken out of the ready heap and run in
+			the background, whenever no other task is ready. */
+			if( uxDeadlineHeapRemove( &( pxIdleTCB->xStateHeapItem ) ) == ( UBaseType_t ) 0 )
+			{
+				taskRESET_READY_PRIORITY( pxIdleTCB->uxPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxCurrentTCB = prvGetTaskToRun_EDF();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_EDF_SCHEDULER */
+
 	#if ( configUSE_TIMERS == 1 )
 	{
 		if( xReturn == pdPASS )
@@ -2112,6 +3504,14 @@ BaseType_t xReturn;
 
 		xNextTaskUnblockTime = portMAX_DELAY;
 		xSchedulerRunning = pdTRUE;
+
+		#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_SRP_MUTEXES == 1 ) )
+		{
+			/* The first task runs without being selected by
+			vTaskSwitchContext(). */
+			pxCurrentTCB->ucJobStarted = pdTRUE;
+		}
+		#endif
 		xTickCount = ( TickType_t ) 0U;
 
 		/* If configGENERATE_RUN_TIME_STATS is defined then the following
@@ -2180,7 +3580,41 @@ void vTaskSuspendAll( void )
 		configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
 		task that are in the Ready state, even though the idle task is
 		running. */
-		#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+		#if( configUSE_EDF_SCHEDULER == 1 )
+		{
+			/* The idle task is not in a ready heap, so a task in any of them
+			is ready to run in its place.  The heaps are only read, as this
+			is called before the scheduler is suspended. */
+			#if ( configUSE_EDF_PRIORITY_BANDS == 1 )
+			{
+			UBaseType_t uxPriority;
+
+				for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+				{
+					if( heapHEAP_IS_EMPTY( &( xReadyTasksHeapsEDF[ uxPriority ] ) ) == pdFALSE )
+					{
+						uxHigherPriorityReadyTasks = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			#else
+			{
+				if( heapHEAP_IS_EMPTY( &xReadyTasksHeapEDF ) == pdFALSE )
+				{
+					uxHigherPriorityReadyTasks = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_EDF_PRIORITY_BANDS */
+		}
+		#elif( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 		{
 			if( uxTopReadyPriority > tskIDLE_PRIORITY )
 			{
@@ -2203,7 +3637,11 @@ void vTaskSuspendAll( void )
 		}
 		#endif
 
+		#if( configUSE_EDF_SCHEDULER == 1 )
+		if( pxCurrentTCB != ( TCB_t * ) xIdleTaskHandle )
+		#else
 		if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
+		#endif
 		{
 			xReturn = 0;
 		}
@@ -2223,7 +3661,37 @@ void vTaskSuspendAll( void )
 		}
 		else
 		{
-			xReturn = xNextTaskUnblockTime - xTickCount;
+			xReturn = xNextTaskUnblockTime;
+
+			#if( configUSE_EDF_SCHEDULER == 1 )
+			{
+				/* Jobs are released from the release heap rather than the
+				delayed list. */
+				if( xNextReleaseTimeEDF < xReturn )
+				{
+					xReturn = xNextReleaseTimeEDF;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* A job blocked part way through, for example on a queue,
+				is still outstanding.  The tick after its deadline has to be
+				processed to find out whether the deadline was missed, so
+				that tick cannot be suppressed either. */
+				if( xNextJobDeadline < xReturn )
+				{
+					xReturn = xNextJobDeadline + ( TickType_t ) 1;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_EDF_SCHEDULER */
+
+			xReturn -= xTickCount;
 		}
 
 		return xReturn;
@@ -2236,6 +3704,9 @@ BaseType_t xTaskResumeAll( void )
 {
 TCB_t *pxTCB = NULL;
 BaseType_t xAlreadyYielded = pdFALSE;
+#if ( configUSE_EDF_SCHEDULER == 1 )
+	TCB_t *pxEarliestReadiedTCB = NULL;
+#endif
 
 	/* If uxSchedulerSuspended is zero then this function does not match a
 	previous call to vTaskSuspendAll(). */
@@ -2261,11 +3732,33 @@ BaseType_t xAlreadyYielded = pdFALSE;
 					pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) );
 					( void ) uxListRemove( &( pxTCB->xEventListItem ) );
 					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-					prvAddTaskToReadyList( pxTCB );
+					prvAddUnblockedTaskToReadyList( pxTCB );
+
+					#if ( configUSE_EDF_SCHEDULER == 1 )
+					{
+						/* The decision is taken once for every pending ready
+						task, below. */
+						pxEarliestReadiedTCB = prvEarliestReadiedTask_EDF( pxEarliestReadiedTCB, pxTCB );
+					}
+					#else
+					{
+						/* If the moved task has a priority higher than the
+						current task then a yield must be performed. */
+						if( taskHAS_PRIORITY_OF_CURRENT_OR_ABOVE( pxTCB ) )
+						{
+							xYieldPending = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_EDF_SCHEDULER */
+				}
 
-					/* If the moved task has a priority higher than the current
-					task then a yield must be performed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+				#if ( configUSE_EDF_SCHEDULER == 1 )
+				{
+					if( ( pxEarliestReadiedTCB != NULL ) && ( taskHAS_PRIORITY_OF_CURRENT_OR_ABOVE( pxEarliestReadiedTCB ) ) )
 					{
 						xYieldPending = pdTRUE;
 					}
@@ -2274,6 +3767,7 @@ BaseType_t xAlreadyYielded = pdFALSE;
 						mtCOVERAGE_TEST_MARKER();
 					}
 				}
+				#endif /* configUSE_EDF_SCHEDULER */
 
 				if( pxTCB != NULL )
 				{
@@ -2501,10 +3995,14 @@ TCB_t *pxTCB;
 				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
 			}
 
-			if( pxTCB == NULL )
+			#if( configUSE_64_BIT_TICKS == 0 )
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				}
 			}
+			#endif
 
 			#if ( INCLUDE_vTaskSuspend == 1 )
 			{
@@ -2557,7 +4055,11 @@ TCB_t *pxTCB;
 				/* Fill in an TaskStatus_t structure with information on each
 				task in the Blocked state. */
 				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				#if( configUSE_64_BIT_TICKS == 0 )
+				{
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				}
+				#endif
 
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
@@ -2633,6 +4135,14 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 		was suppressed.  Note this does *not* call the tick hook function for
 		each stepped tick. */
 		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+		#if( configUSE_EDF_SCHEDULER == 1 )
+		{
+			/* Releases and the deadline miss check are made by the tick, so
+			neither must be stepped over. */
+			configASSERT( ( xTickCount + xTicksToJump ) <= xNextReleaseTimeEDF );
+			configASSERT( ( xTickCount + xTicksToJump ) <= xNextJobDeadline );
+		}
+		#endif
 		xTickCount += xTicksToJump;
 		traceINCREASE_TICK_COUNT( xTicksToJump );
 	}
@@ -2657,10 +4167,10 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 			{
 				xReturn = pdPASS;
 
-				/* Remove the reference to the task from the blocked list.  An
-				interrupt won't touch the xStateListItem because the
-				scheduler is suspended. */
-				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				/* Remove the reference to the task from the blocked list, or
+				under EDF from the release heap.  An interrupt won't touch the
+				xStateListItem because the scheduler is suspended. */
+				( void ) taskREMOVE_FROM_STATE_LIST( pxTCB );
 
 				/* Is the task waiting on an event also?  If so remove it from
 				the event list too.  Interrupts can touch the event list item,
@@ -2681,7 +4191,7 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 				taskEXIT_CRITICAL();
 
 				/* Place the unblocked task into the appropriate ready list. */
-				prvAddTaskToReadyList( pxTCB );
+				prvAddUnblockedTaskToReadyList( pxTCB );
 
 				/* A task being unblocked cannot cause an immediate context
 				switch if preemption is turned off. */
@@ -2690,7 +4200,7 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					if( taskHAS_PRIORITY_OVER_CURRENT( pxTCB ) )
 					{
 						/* Pend the yield to be performed when the scheduler
 						is unsuspended. */
@@ -2721,6 +4231,9 @@ BaseType_t xTaskIncrementTick( void )
 TCB_t * pxTCB;
 TickType_t xItemValue;
 BaseType_t xSwitchRequired = pdFALSE;
+#if ( configUSE_EDF_SCHEDULER == 1 )
+	TCB_t *pxEarliestReadiedTCB = NULL;
+#endif
 
 	/* Called by the portable layer each time a tick interrupt occurs.
 	Increments the tick then checks to see if the new tick value will cause any
@@ -2736,14 +4249,126 @@ BaseType_t xSwitchRequired = pdFALSE;
 		delayed lists if it wraps to 0. */
 		xTickCount = xConstTickCount;
 
-		if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+		#if ( configUSE_EDF_SCHEDULER == 1 )
 		{
-			taskSWITCH_DELAYED_LISTS();
+			/* Charge the tick that has just ended to the budget of the running
+			task if it is a CBS task, or to the current job if it is a periodic
+			task.  A task that has just left the ready heap, for example
+			because the tick was pended while it was blocking, has nothing to
+			be charged to. */
+			if( taskIS_IN_READY_LIST( pxCurrentTCB, pxCurrentTCB->uxPriority ) == pdFALSE )
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			else if( pxCurrentTCB->xServerBudget != ( TickType_t ) 0U )
+			{
+				if( pxCurrentTCB->xRemainingBudget > ( TickType_t ) 1U )
+				{
+					( pxCurrentTCB->xRemainingBudget )--;
+				}
+				else
+				{
+					/* The postponed deadline may no longer be the earliest. */
+					prvReplenishServer_CBS( pxCurrentTCB );
+					xSwitchRequired = pdTRUE;
+				}
+			}
+			else if( taskIS_PERIODIC_EDF( pxCurrentTCB ) )
+			{
+				( pxCurrentTCB->xJobExecutionTime )++;
+
+				#if ( configUSE_EDF_MK_FIRM == 1 )
+				if( prvJobShouldBeSkipped_EDF( pxCurrentTCB, xConstTickCount ) != pdFALSE )
+				{
+					prvSkipJob_EDF( pxCurrentTCB );
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				#endif /* configUSE_EDF_MK_FIRM */
+				if( ( pxCurrentTCB->xJobExecutionTime > pxCurrentTCB->xTaskWCET ) &&
+					( pxCurrentTCB->xTaskWCET != ( TickType_t ) 0U ) &&
+					( pxCurrentTCB->ucJobOverrun == pdFALSE ) &&
+					( pxCurrentTCB->ucJobAborted == pdFALSE ) )
+				{
+					prvBudgetOverrun_EDF( pxCurrentTCB );
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					#if ( configEDF_SCHEDULING_POLICY == edfPOLICY_LLF )
+					{
+						/* The laxity of the running job is used up while a
+						waiting job keeps its laxity, so a waiting job may now
+						have the least. */
+						if( pxCurrentTCB->xJobExecutionTime <= pxCurrentTCB->xTaskWCET )
+						{
+							( void ) uxDeadlineHeapRemove( &( pxCurrentTCB->xStateHeapItem ) );
+							heapSET_HEAP_ITEM_VALUE( &( pxCurrentTCB->xStateHeapItem ), taskSCHEDULING_KEY_EDF( pxCurrentTCB ) );
+							vDeadlineHeapInsert( taskREADY_HEAP_EDF( pxCurrentTCB->uxPriority ), &( pxCurrentTCB->xStateHeapItem ) );
+
+							if( heapGET_OWNER_OF_HEAD_ITEM( taskREADY_HEAP_EDF( pxCurrentTCB->uxPriority ) ) != ( void * ) pxCurrentTCB )
+							{
+								xSwitchRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+					#endif /* configEDF_SCHEDULING_POLICY */
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			#if ( configUSE_EDF_LIMITED_PREEMPTION == 1 )
+			{
+				/* The preemption deferred by a non-preemptive region takes
+				place once the region has been executed. */
+				if( pxCurrentTCB->ucPreemptionDeferred != pdFALSE )
+				{
+					if( pxCurrentTCB->xNonPreemptiveTicksLeft > ( TickType_t ) 1U )
+					{
+						( pxCurrentTCB->xNonPreemptiveTicksLeft )--;
+					}
+					else
+					{
+						pxCurrentTCB->xNonPreemptiveTicksLeft = ( TickType_t ) 0U;
+						xSwitchRequired = pdTRUE;
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_EDF_LIMITED_PREEMPTION */
 		}
-		else
+		#endif /* configUSE_EDF_SCHEDULER */
+
+		#if ( configUSE_64_BIT_TICKS == 0 )
 		{
-			mtCOVERAGE_TEST_MARKER();
+			if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+			{
+				taskSWITCH_DELAYED_LISTS();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
+		#endif /* configUSE_64_BIT_TICKS */
 
 		/* See if this tick has made a timeout expire.  Tasks are stored in
 		the	queue in the order of their wake time - meaning once one task
@@ -2803,17 +4428,23 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 					/* Place the unblocked task into the appropriate ready
 					list. */
-					prvAddTaskToReadyList( pxTCB );
+					prvAddUnblockedTaskToReadyList( pxTCB );
 
 					/* A task being unblocked cannot cause an immediate
 					context switch if preemption is turned off. */
-					#if (  configUSE_PREEMPTION == 1 )
+					#if ( configUSE_EDF_SCHEDULER == 1 )
+					{
+						/* The decision is taken once for every task made
+						ready by this tick, below. */
+						pxEarliestReadiedTCB = prvEarliestReadiedTask_EDF( pxEarliestReadiedTCB, pxTCB );
+					}
+					#elif (  configUSE_PREEMPTION == 1 )
 					{
 						/* Preemption is on, but a context switch should
 						only be performed if the unblocked task has a
 						priority that is equal to or higher than the
 						currently executing task. */
-						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						if( taskHAS_PRIORITY_OF_CURRENT_OR_ABOVE( pxTCB ) )
 						{
 							xSwitchRequired = pdTRUE;
 						}
@@ -2827,6 +4458,78 @@ BaseType_t xSwitchRequired = pdFALSE;
 			}
 		}
 
+		#if ( configUSE_EDF_SCHEDULER == 1 )
+		{
+			/* Release the jobs that fall due on this tick.  As with
+			xNextTaskUnblockTime, the release heap is only looked at when its
+			earliest release time is reached. */
+			if( xConstTickCount >= xNextReleaseTimeEDF )
+			{
+				pxEarliestReadiedTCB = prvReleaseDueJobs_EDF( xConstTickCount, pxEarliestReadiedTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* One preemption decision for every task unblocked or released
+			by this tick. */
+			#if ( configUSE_PREEMPTION == 1 )
+			{
+				if( ( pxEarliestReadiedTCB != NULL ) && ( taskHAS_PRIORITY_OF_CURRENT_OR_ABOVE( pxEarliestReadiedTCB ) ) )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_PREEMPTION */
+
+			/* A job misses its deadline if it is still outstanding once the
+			tick count has passed its absolute deadline - a job that completes
+			during the tick period that ends at its deadline is on time.  The
+			outstanding jobs are held in deadline order, so as with
+			xNextTaskUnblockTime only the earliest deadline needs to be checked
+			each tick. */
+			if( xConstTickCount > xNextJobDeadline )
+			{
+				do
+				{
+					pxTCB = ( TCB_t * ) heapGET_OWNER_OF_HEAD_ITEM( &xOutstandingJobsHeapEDF );
+					( void ) uxDeadlineHeapRemove( &( pxTCB->xDeadlineHeapItem ) );
+
+					#if ( configUSE_EDF_MK_FIRM == 1 )
+					if( prvJobCanBeSkipped_EDF( pxTCB ) != pdFALSE )
+					{
+						/* Rather than let the late job delay the jobs behind
+						it, skip it while the constraint allows. */
+						prvSkipJob_EDF( pxTCB );
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					#endif /* configUSE_EDF_MK_FIRM */
+					{
+						( pxTCB->uxDeadlineMisses )++;
+
+						#if ( configUSE_DEADLINE_MISS_HOOK == 1 )
+						{
+							vApplicationDeadlineMissHook( pxTCB, heapGET_HEAP_ITEM_VALUE( &( pxTCB->xDeadlineHeapItem ) ) );
+						}
+						#endif /* configUSE_DEADLINE_MISS_HOOK */
+					}
+
+					prvResetNextJobDeadline();
+				} while( xConstTickCount > xNextJobDeadline );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_EDF_SCHEDULER */
+
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
 		writer has not explicitly turned time slicing off. */
@@ -3029,7 +4732,31 @@ void vTaskSwitchContext( void )
 		}
 		#else
 		{
-			pxCurrentTCB = (TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &(xReadyTasksListEDF ) );
+			#if ( configUSE_EDF_LIMITED_PREEMPTION == 1 )
+				TCB_t * const pxRunningTCB = pxCurrentTCB;
+			#endif
+
+			#if ( configUSE_SRP_MUTEXES == 1 )
+			{
+				prvApplySystemCeiling_SRP();
+			}
+			#endif
+
+			/* The head of the ready heap is the task with the earliest
+			deadline.  The idle task runs if the ready heaps are empty. */
+			pxCurrentTCB = prvGetTaskToRun_EDF();
+
+			#if ( configUSE_EDF_LIMITED_PREEMPTION == 1 )
+			{
+				pxCurrentTCB = prvLimitPreemption_EDF( pxRunningTCB, pxCurrentTCB );
+			}
+			#endif
+
+			#if ( configUSE_SRP_MUTEXES == 1 )
+			{
+				pxCurrentTCB->ucJobStarted = pdTRUE;
+			}
+			#endif
 		}
 		#endif
 		
@@ -3048,16 +4775,52 @@ void vTaskSwitchContext( void )
 
 void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
 {
+#if( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_PRIORITY_BANDS == 1 ) )
+	ListItem_t *pxPosition;
+	const ListItem_t * const pxEnd = listGET_END_MARKER( pxEventList );
+#endif
+
 	configASSERT( pxEventList );
 
 	/* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
 	SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
 
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+	{
+		/* Order the waiting tasks as the ready heap orders them, by the value
+		of the scheduling policy (the deadline of the current job under EDF).
+		The event list item value is reset to the task priority by the same
+		code paths that reset it after it has been borrowed by an event
+		group. */
+		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), taskSCHEDULING_KEY_EDF( pxCurrentTCB ) );
+	}
+	#endif /* configUSE_EDF_SCHEDULER */
+
 	/* Place the event list item of the TCB in the appropriate event list.
-	This is placed in the list in priority order so the highest priority task
-	is the first to be woken by the event.  The queue that contains the event
-	list is locked, preventing simultaneous access from interrupts. */
-	vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+	This is placed in the list in priority order (deadline order under EDF) so
+	the highest priority task is the first to be woken by the event.  The queue
+	that contains the event list is locked, preventing simultaneous access from
+	interrupts. */
+	#if( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_PRIORITY_BANDS == 1 ) )
+	{
+		/* A task in a higher band runs first whatever its value, so the item
+		value alone cannot give the position.  Walk past every waiting task
+		that runs before the calling task, or that runs at the same point, so
+		waiting tasks that are equal are woken in FIFO order. */
+		pxPosition = ( ListItem_t * ) &( pxEventList->xListEnd ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+
+		while( ( listGET_NEXT( pxPosition ) != pxEnd ) && ( taskRUNS_BEFORE_EDF( pxCurrentTCB, ( TCB_t * ) listGET_LIST_ITEM_OWNER( listGET_NEXT( pxPosition ) ) ) == pdFALSE ) )
+		{
+			pxPosition = listGET_NEXT( pxPosition );
+		}
+
+		vListInsertAfter( pxEventList, pxPosition, &( pxCurrentTCB->xEventListItem ) );
+	}
+	#else
+	{
+		vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+	}
+	#endif
 
 	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
 }
@@ -3145,7 +4908,7 @@ BaseType_t xReturn;
 	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 	{
 		( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
-		prvAddTaskToReadyList( pxUnblockedTCB );
+		prvAddUnblockedTaskToReadyList( pxUnblockedTCB );
 	}
 	else
 	{
@@ -3154,7 +4917,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskHAS_PRIORITY_OVER_CURRENT( pxUnblockedTCB ) )
 	{
 		/* Return true if the task removed from the event list has a higher
 		priority than the calling task.  This allows the calling task to know if
@@ -3209,9 +4972,9 @@ TCB_t *pxUnblockedTCB;
 	scheduler is suspended so interrupts will not be accessing the ready
 	lists. */
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
-	prvAddTaskToReadyList( pxUnblockedTCB );
+	prvAddUnblockedTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskHAS_PRIORITY_OVER_CURRENT( pxUnblockedTCB ) )
 	{
 		/* The unblocked task has a priority above that of the calling task, so
 		a context switch is required.  This function is called with the
@@ -3462,159 +5225,1819 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 					}
 					else
 					{
-						mtCOVERAGE_TEST_MARKER();
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				( void ) xTaskResumeAll();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TICKLESS_IDLE */
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_IDLE != 0 )
+
+	eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+	{
+	/* The idle task exists in addition to the application tasks. */
+	const UBaseType_t uxNonApplicationTasks = 1;
+	eSleepModeStatus eReturn = eStandardSleep;
+
+		if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
+		{
+			/* A task was made ready while the scheduler was suspended. */
+			eReturn = eAbortSleep;
+		}
+		else if( xYieldPending != pdFALSE )
+		{
+			/* A yield was pended while the scheduler was suspended. */
+			eReturn = eAbortSleep;
+		}
+		else
+		{
+			/* If all the tasks are in the suspended list (which might mean they
+			have an infinite block time rather than actually being suspended)
+			then it is safe to turn all clocks off and just wait for external
+			interrupts - unless, under EDF, a job blocked part way through
+			still has a deadline to be checked. */
+			#if( configUSE_EDF_SCHEDULER == 1 )
+			if( ( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) ) &&
+				( heapHEAP_IS_EMPTY( &xOutstandingJobsHeapEDF ) != pdFALSE ) )
+			#else
+			if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+			#endif
+			{
+				eReturn = eNoTasksWaitingTimeout;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return eReturn;
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+
+	void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue )
+	{
+	TCB_t *pxTCB;
+
+		if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+		{
+			pxTCB = prvGetTCBFromHandle( xTaskToSet );
+			pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+		}
+	}
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+
+	void *pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery, BaseType_t xIndex )
+	{
+	void *pvReturn = NULL;
+	TCB_t *pxTCB;
+
+		if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+		{
+			pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+			pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
+		}
+		else
+		{
+			pvReturn = NULL;
+		}
+
+		return pvReturn;
+	}
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+/*-----------------------------------------------------------*/
+
+#if ( portUSING_MPU_WRAPPERS == 1 )
+
+	void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify, const MemoryRegion_t * const xRegions )
+	{
+	TCB_t *pxTCB;
+
+		/* If null is passed in here then we are modifying the MPU settings of
+		the calling task. */
+		pxTCB = prvGetTCBFromHandle( xTaskToModify );
+
+		vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
+	}
+
+#endif /* portUSING_MPU_WRAPPERS */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseTaskLists( void )
+{
+	#if (configUSE_EDF_SCHEDULER == 1)
+	{
+		#if ( configUSE_EDF_PRIORITY_BANDS == 1 )
+		{
+			UBaseType_t uxPriority;
+			for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+			{
+				vDeadlineHeapInitialise( &( xReadyTasksHeapsEDF[ uxPriority ] ) );
+			}
+		}
+		#else
+		{
+			vDeadlineHeapInitialise( &xReadyTasksHeapEDF );
+		}
+		#endif
+
+		vDeadlineHeapInitialise( &xOutstandingJobsHeapEDF );
+		vListInitialise( &xWaitingForArrivalListEDF );
+
+		vDeadlineHeapInitialise( &xReleaseHeapEDF1 );
+		pxReleaseHeapEDF = &xReleaseHeapEDF1;
+
+		#if ( configUSE_EDF_ELASTIC_TASKS == 1 )
+		{
+			vListInitialise( &xElasticTasksListEDF );
+		}
+		#endif
+
+		#if ( configUSE_SRP_MUTEXES == 1 )
+		{
+			vDeadlineHeapInitialise( &xCeilingBlockedHeapSRP );
+		}
+		#endif
+	}
+	#else
+	{
+		UBaseType_t uxPriority;
+		for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+		{
+			vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+		}
+	}
+	#endif
+
+	vListInitialise( &xDelayedTaskList1 );
+	#if( configUSE_64_BIT_TICKS == 0 )
+	{
+		vListInitialise( &xDelayedTaskList2 );
+	}
+	#endif
+	vListInitialise( &xPendingReadyList );
+
+	#if ( INCLUDE_vTaskDelete == 1 )
+	{
+		vListInitialise( &xTasksWaitingTermination );
+	}
+	#endif /* INCLUDE_vTaskDelete */
+
+	#if ( INCLUDE_vTaskSuspend == 1 )
+	{
+		vListInitialise( &xSuspendedTaskList );
+	}
+	#endif /* INCLUDE_vTaskSuspend */
+
+	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+	using list2. */
+	pxDelayedTaskList = &xDelayedTaskList1;
+	#if( configUSE_64_BIT_TICKS == 0 )
+	{
+		pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static UBaseType_t prvRemoveTaskFromStateList( TCB_t *pxTCB )
+	{
+	UBaseType_t uxReturn;
+
+		/* A ready task is referenced from the ready heap rather than from a
+		list, in which case its xStateListItem is not in any list. */
+		#if ( configUSE_SRP_MUTEXES == 1 )
+		if( heapIS_CONTAINED_WITHIN( &xCeilingBlockedHeapSRP, &( pxTCB->xStateHeapItem ) ) != pdFALSE )
+		{
+			/* The ready heap is not changed, and its ready priority was
+			already reset if the job emptied it when it was held back, so the
+			caller must not reset it again. */
+			( void ) uxDeadlineHeapRemove( &( pxTCB->xStateHeapItem ) );
+			uxReturn = ( UBaseType_t ) 1U;
+		}
+		else
+		#endif /* configUSE_SRP_MUTEXES */
+		if( heapHEAP_ITEM_CONTAINER( &( pxTCB->xStateHeapItem ) ) != NULL )
+		{
+			uxReturn = uxDeadlineHeapRemove( &( pxTCB->xStateHeapItem ) );
+		}
+		else
+		{
+			uxReturn = uxListRemove( &( pxTCB->xStateListItem ) );
+		}
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static void prvReleaseJob_EDF( TCB_t *pxTCB, TickType_t xReleaseTime )
+	{
+	BaseType_t xIsReady;
+
+		/* The absolute deadline is the ready heap key, so it cannot change
+		while the task is in the heap. */
+		xIsReady = taskIS_IN_READY_LIST( pxTCB, pxTCB->uxPriority );
+
+		if( xIsReady != pdFALSE )
+		{
+			( void ) uxDeadlineHeapRemove( &( pxTCB->xStateHeapItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxTCB->xJobRelease = xReleaseTime;
+		pxTCB->xJobDeadline = xReleaseTime + pxTCB->xTaskDeadline;
+		( pxTCB->uxJobNumber )++;
+		pxTCB->xJobExecutionTime = ( TickType_t ) 0U;
+		pxTCB->ucJobOverrun = pdFALSE;
+		pxTCB->ucJobAborted = pdFALSE;
+
+		#if ( configUSE_SRP_MUTEXES == 1 )
+		{
+			pxTCB->ucJobStarted = pdFALSE;
+		}
+		#endif
+
+		/* The previous job must have completed before the next is released. */
+		configASSERT( heapHEAP_ITEM_CONTAINER( &( pxTCB->xDeadlineHeapItem ) ) == NULL );
+		heapSET_HEAP_ITEM_VALUE( &( pxTCB->xDeadlineHeapItem ), pxTCB->xJobDeadline );
+		vDeadlineHeapInsert( &xOutstandingJobsHeapEDF, &( pxTCB->xDeadlineHeapItem ) );
+
+		if( pxTCB->xJobDeadline < xNextJobDeadline )
+		{
+			xNextJobDeadline = pxTCB->xJobDeadline;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xIsReady != pdFALSE )
+		{
+			prvAddTaskToReadyList( pxTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReleasePendingJob_EDF( void )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( pxCurrentTCB->ucWaitingForRelease != pdFALSE )
+			{
+				/* The item value of the state list item still holds the time
+				at which the job was due to be released, see
+				prvAddCurrentTaskToReleaseHeap_EDF(). */
+				pxCurrentTCB->ucWaitingForRelease = pdFALSE;
+				prvReleaseJob_EDF( pxCurrentTCB, listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ) ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvAddCurrentTaskToReleaseHeap_EDF( const TickType_t xReleaseTime )
+	{
+		#if( INCLUDE_xTaskAbortDelay == 1 )
+		{
+			/* As in prvAddCurrentTaskToDelayedList(). */
+			pxCurrentTCB->ucDelayAborted = pdFALSE;
+		}
+		#endif
+
+		/* The current task must be in a ready heap, so the port reset macro
+		can be called directly. */
+		if( taskREMOVE_FROM_STATE_LIST( pxCurrentTCB ) == ( UBaseType_t ) 0 )
+		{
+			portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxCurrentTCB->ucWaitingForRelease = pdTRUE;
+
+		/* The heap item value is replaced by the scheduling key once the task
+		is ready, so the release time is also kept in the state list item,
+		which is not in any list, for prvReleasePendingJob_EDF(). */
+		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xReleaseTime );
+		heapSET_HEAP_ITEM_VALUE( &( pxCurrentTCB->xStateHeapItem ), xReleaseTime );
+
+		/* The tick count does not overflow, so there is only one release
+		heap. */
+		vDeadlineHeapInsert( pxReleaseHeapEDF, &( pxCurrentTCB->xStateHeapItem ) );
+
+		if( xReleaseTime < xNextReleaseTimeEDF )
+		{
+			xNextReleaseTimeEDF = xReleaseTime;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static TCB_t *prvReleaseDueJobs_EDF( const TickType_t xConstTickCount, TCB_t *pxEarliestTCB )
+	{
+	TCB_t *pxTCB;
+	TickType_t xReleaseTime;
+
+		while( heapHEAP_IS_EMPTY( pxReleaseHeapEDF ) == pdFALSE )
+		{
+			pxTCB = ( TCB_t * ) heapGET_OWNER_OF_HEAD_ITEM( pxReleaseHeapEDF );
+			xReleaseTime = heapGET_HEAP_ITEM_VALUE( &( pxTCB->xStateHeapItem ) );
+
+			if( xConstTickCount < xReleaseTime )
+			{
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			( void ) uxDeadlineHeapRemove( &( pxTCB->xStateHeapItem ) );
+			pxTCB->ucWaitingForRelease = pdFALSE;
+
+			/* Release the job before the task is keyed into the ready
+			heap. */
+			if( pxTCB->ucSporadic == pdFALSE )
+			{
+				prvReleaseJob_EDF( pxTCB, xReleaseTime );
+			}
+			else if( pxTCB->uxPendingReleases != ( UBaseType_t ) 0U )
+			{
+				/* An arrival during the minimum inter-arrival time was
+				deferred until now. */
+				prvReleaseArrivedJob_EDF( pxTCB, xReleaseTime );
+			}
+			else
+			{
+				/* Nothing has arrived, so the task stays blocked until
+				xTaskReleaseJobFromISR_EDF() is called. */
+				vListInsertEnd( &xWaitingForArrivalListEDF, &( pxTCB->xStateListItem ) );
+				continue;
+			}
+
+			prvAddTaskToReadyList( pxTCB );
+			pxEarliestTCB = prvEarliestReadiedTask_EDF( pxEarliestTCB, pxTCB );
+		}
+
+		prvResetNextReleaseTime_EDF();
+
+		return pxEarliestTCB;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvResetNextReleaseTime_EDF( void )
+	{
+		if( heapHEAP_IS_EMPTY( pxReleaseHeapEDF ) != pdFALSE )
+		{
+			xNextReleaseTimeEDF = portMAX_DELAY;
+		}
+		else
+		{
+			xNextReleaseTimeEDF = heapGET_ITEM_VALUE_OF_HEAD_ITEM( pxReleaseHeapEDF );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvWaitForNextRelease_EDF( const TickType_t xConstTickCount )
+	{
+	const TickType_t xNextRelease = pxCurrentTCB->xJobRelease + pxCurrentTCB->xTaskPeriod;
+
+		/* The next release is in the future if it falls within one period
+		of the current time. */
+		if( ( TickType_t ) ( ( xNextRelease - xConstTickCount ) - ( TickType_t ) 1U ) < pxCurrentTCB->xTaskPeriod )
+		{
+			traceTASK_DELAY_UNTIL( xNextRelease );
+
+			/* The job is released by the tick that unblocks the task, at
+			which point the wake time is the release time.  A sporadic task
+			with no arrival pending by then moves on to wait for one. */
+			prvAddCurrentTaskToReleaseHeap_EDF( xNextRelease );
+		}
+		else if( pxCurrentTCB->ucSporadic == pdFALSE )
+		{
+			/* The job overran its period, so the next job was due at or
+			before the current time.  Release it straight away so the release
+			times stay aligned to the period. */
+			prvReleaseJob_EDF( pxCurrentTCB, xNextRelease );
+		}
+		else if( pxCurrentTCB->uxPendingReleases != ( UBaseType_t ) 0U )
+		{
+			prvReleaseArrivedJob_EDF( pxCurrentTCB, xNextRelease );
+		}
+		else
+		{
+			/* The minimum inter-arrival time has passed, so the next arrival
+			releases a job as soon as it is signalled. */
+			if( taskREMOVE_FROM_STATE_LIST( pxCurrentTCB ) == ( UBaseType_t ) 0 )
+			{
+				portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			vListInsertEnd( &xWaitingForArrivalListEDF, &( pxCurrentTCB->xStateListItem ) );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReleaseArrivedJob_EDF( TCB_t *pxTCB, TickType_t xEarliestRelease )
+	{
+	TickType_t xReleaseTime;
+
+		configASSERT( pxTCB->uxPendingReleases > ( UBaseType_t ) 0U );
+		( pxTCB->uxPendingReleases )--;
+
+		/* An arrival before xEarliestRelease was early, so its job is
+		deferred until then. */
+		if( ( pxTCB->xPendingArrival - pxTCB->xJobRelease ) > ( xEarliestRelease - pxTCB->xJobRelease ) )
+		{
+			xReleaseTime = pxTCB->xPendingArrival;
+		}
+		else
+		{
+			xReleaseTime = xEarliestRelease;
+		}
+
+		/* Any further pending arrival came no later than this one, so it is
+		released one minimum inter-arrival time after this release. */
+		pxTCB->xPendingArrival = xReleaseTime;
+		prvReleaseJob_EDF( pxTCB, xReleaseTime );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvCompleteJob_EDF( TCB_t *pxTCB, TickType_t xCompletionTime )
+	{
+	TickType_t xLateness;
+
+		if( pxTCB->xJobExecutionTime > pxTCB->xMaxExecutionTime )
+		{
+			pxTCB->xMaxExecutionTime = pxTCB->xJobExecutionTime;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( pxTCB->ucJobAborted != pdFALSE )
+		{
+			/* The job was recorded when it was abandoned, so there is
+			nothing left to complete. */
+			return;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if ( configUSE_EDF_MK_FIRM == 1 )
+		{
+			pxTCB->ulMKHistory <<= 1;
+
+			if( heapHEAP_ITEM_CONTAINER( &( pxTCB->xDeadlineHeapItem ) ) != NULL )
+			{
+				pxTCB->ulMKHistory |= ( uint32_t ) 1U;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_EDF_MK_FIRM */
+
+		if( heapHEAP_ITEM_CONTAINER( &( pxTCB->xDeadlineHeapItem ) ) != NULL )
+		{
+			/* The job completed by its deadline. */
+			( void ) uxDeadlineHeapRemove( &( pxTCB->xDeadlineHeapItem ) );
+			prvResetNextJobDeadline();
+		}
+		else
+		{
+			/* The tick already removed the job when it missed its deadline,
+			so its lateness is only known now.  The item value still holds the
+			deadline of the job even if the job was demoted to the background
+			after overrunning its WCET. */
+			xLateness = xCompletionTime - heapGET_HEAP_ITEM_VALUE( &( pxTCB->xDeadlineHeapItem ) );
+			pxTCB->xTotalTardiness += xLateness;
+
+			if( xLateness > pxTCB->xMaxLateness )
+			{
+				pxTCB->xMaxLateness = xLateness;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvResetNextJobDeadline( void )
+	{
+		if( heapHEAP_IS_EMPTY( &xOutstandingJobsHeapEDF ) != pdFALSE )
+		{
+			xNextJobDeadline = portMAX_DELAY;
+		}
+		else
+		{
+			xNextJobDeadline = heapGET_ITEM_VALUE_OF_HEAD_ITEM( &xOutstandingJobsHeapEDF );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvWakeServer_CBS( TCB_t *pxTCB )
+	{
+	const TickType_t xConstTickCount = xTickCount;
+
+		/* The server deadline is kept if the remaining budget can be consumed
+		by that deadline at no more than the server bandwidth, that is if
+		c < ( d - r ) * Q / T.  Otherwise, including when the deadline has
+		passed, the server starts afresh. */
+		if( ( pxTCB->xJobDeadline <= xConstTickCount ) ||
+			( ( ( uint64_t ) pxTCB->xRemainingBudget * pxTCB->xTaskPeriod ) >= ( ( uint64_t ) ( pxTCB->xJobDeadline - xConstTickCount ) * pxTCB->xServerBudget ) ) )
+		{
+			pxTCB->xJobRelease = xConstTickCount;
+			pxTCB->xJobDeadline = xConstTickCount + pxTCB->xTaskPeriod;
+			pxTCB->xRemainingBudget = pxTCB->xServerBudget;
+			( pxTCB->uxJobNumber )++;
+
+			#if ( configUSE_SRP_MUTEXES == 1 )
+			{
+				pxTCB->ucJobStarted = pdFALSE;
+			}
+			#endif
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReplenishServer_CBS( TCB_t *pxTCB )
+	{
+	BaseType_t xIsReady;
+
+		/* The server deadline is the ready heap key, so the task is taken out
+		of the heap while it changes.  prvAddUnblockedTaskToReadyList() is not
+		used to put it back as the task is not waking. */
+		xIsReady = taskIS_IN_READY_LIST( pxTCB, pxTCB->uxPriority );
+
+		if( xIsReady != pdFALSE )
+		{
+			( void ) uxDeadlineHeapRemove( &( pxTCB->xStateHeapItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxTCB->xRemainingBudget = pxTCB->xServerBudget;
+		pxTCB->xJobDeadline += pxTCB->xTaskPeriod;
+
+		if( xIsReady != pdFALSE )
+		{
+			heapSET_HEAP_ITEM_VALUE( &( pxTCB->xStateHeapItem ), taskSCHEDULING_KEY_EDF( pxTCB ) );
+			vDeadlineHeapInsert( taskREADY_HEAP_EDF( pxTCB->uxPriority ), &( pxTCB->xStateHeapItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvBudgetOverrun_EDF( TCB_t *pxTCB )
+	{
+		/* pxTCB is the running task, so is in the ready heap. */
+		pxTCB->ucJobOverrun = pdTRUE;
+		( pxTCB->uxBudgetOverruns )++;
+
+		#if ( configUSE_BUDGET_OVERRUN_HOOK == 1 )
+		{
+			vApplicationBudgetOverrunHook( pxTCB, pxTCB->xTaskWCET );
+		}
+		#endif /* configUSE_BUDGET_OVERRUN_HOOK */
+
+		if( pxTCB->ucOverrunAction == ( uint8_t ) eOverrunDemote )
+		{
+			/* The rest of the job runs only when no job with a deadline is
+			ready.  The deadline miss watchdog still uses the real deadline,
+			which is held in xDeadlineHeapItem. */
+			( void ) uxDeadlineHeapRemove( &( pxTCB->xStateHeapItem ) );
+			pxTCB->xJobDeadline = portMAX_DELAY;
+			heapSET_HEAP_ITEM_VALUE( &( pxTCB->xStateHeapItem ), taskSCHEDULING_KEY_EDF( pxTCB ) );
+			vDeadlineHeapInsert( taskREADY_HEAP_EDF( pxTCB->uxPriority ), &( pxTCB->xStateHeapItem ) );
+		}
+		else if( pxTCB->ucOverrunAction == ( uint8_t ) eOverrunAbort )
+		{
+			prvAbortJob_EDF( pxTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvAbortJob_EDF( TCB_t *pxTCB )
+	{
+		/* The kernel cannot unwind the stack of the task, so the job is only
+		abandoned as far as the scheduler is concerned.  Blocking the task
+		until its next release would leave the rest of the job to run in the
+		time of the next job, so instead the task keeps running in the
+		background until it polls xTaskIsJobAborted_EDF() or finishes the
+		job. */
+		pxTCB->ucJobAborted = pdTRUE;
+
+		/* An abandoned job can no longer miss its deadline. */
+		if( heapHEAP_ITEM_CONTAINER( &( pxTCB->xDeadlineHeapItem ) ) != NULL )
+		{
+			( void ) uxDeadlineHeapRemove( &( pxTCB->xDeadlineHeapItem ) );
+			prvResetNextJobDeadline();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if ( configUSE_EDF_MK_FIRM == 1 )
+		{
+			/* An abandoned job did not meet its deadline. */
+			pxTCB->ulMKHistory <<= 1;
+		}
+		#endif
+
+		/* The deadline is the ready heap key, so a ready task is taken out of
+		the heap while it changes.  A blocked task is keyed by the new deadline
+		when it is next made ready. */
+		if( taskIS_IN_READY_LIST( pxTCB, pxTCB->uxPriority ) != pdFALSE )
+		{
+			( void ) uxDeadlineHeapRemove( &( pxTCB->xStateHeapItem ) );
+			pxTCB->xJobDeadline = portMAX_DELAY;
+			heapSET_HEAP_ITEM_VALUE( &( pxTCB->xStateHeapItem ), taskSCHEDULING_KEY_EDF( pxTCB ) );
+			vDeadlineHeapInsert( taskREADY_HEAP_EDF( pxTCB->uxPriority ), &( pxTCB->xStateHeapItem ) );
+		}
+		else
+		{
+			pxTCB->xJobDeadline = portMAX_DELAY;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	#if ( configUSE_EDF_MK_FIRM == 1 )
+
+		static BaseType_t prvJobCanBeSkipped_EDF( const TCB_t * const pxTCB )
+		{
+		uint32_t ulMet;
+		UBaseType_t uxMet = ( UBaseType_t ) 0U;
+
+			if( pxTCB->uxMKWindow == ( UBaseType_t ) 0U )
+			{
+				return pdFALSE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* The current job and the k - 1 jobs before it form a window, so
+			the job can be skipped if at least m of those k - 1 jobs met their
+			deadlines. */
+			ulMet = pxTCB->ulMKHistory & ( ( ( uint32_t ) 1U << ( pxTCB->uxMKWindow - ( UBaseType_t ) 1U ) ) - ( uint32_t ) 1U );
+
+			while( ulMet != ( uint32_t ) 0U )
+			{
+				ulMet &= ulMet - ( uint32_t ) 1U;
+				uxMet++;
+			}
+
+			return ( uxMet >= pxTCB->uxMKMeet ) ? pdTRUE : pdFALSE;
+		}
+		/*-----------------------------------------------------------*/
+
+		static BaseType_t prvJobShouldBeSkipped_EDF( const TCB_t * const pxTCB, const TickType_t xConstTickCount )
+		{
+		BaseType_t xReturn = pdFALSE;
+
+			/* Only a job that has not yet missed its deadline, and has not
+			overrun a declared WCET, is checked here - a job that has missed is
+			handled as the miss is detected. */
+			if( ( pxTCB->uxMKWindow != ( UBaseType_t ) 0U ) &&
+				( pxTCB->xJobExecutionTime < pxTCB->xTaskWCET ) &&
+				( heapHEAP_ITEM_CONTAINER( &( pxTCB->xDeadlineHeapItem ) ) != NULL ) )
+			{
+				if( ( pxTCB->xTaskWCET - pxTCB->xJobExecutionTime ) > ( heapGET_HEAP_ITEM_VALUE( &( pxTCB->xDeadlineHeapItem ) ) - xConstTickCount ) )
+				{
+					xReturn = prvJobCanBeSkipped_EDF( pxTCB );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			return xReturn;
+		}
+		/*-----------------------------------------------------------*/
+
+		static void prvSkipJob_EDF( TCB_t *pxTCB )
+		{
+			/* Whether or not the task is running, the skipped job is the one
+			that is abandoned, so the task's next call to
+			vTaskWaitForNextJob_EDF() ends it and waits for the job after it. */
+			if( pxTCB->ucJobAborted == pdFALSE )
+			{
+				traceTASK_SKIP_JOB( pxTCB );
+
+				( pxTCB->uxSkippedJobs )++;
+				prvAbortJob_EDF( pxTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+	#endif /* configUSE_EDF_MK_FIRM */
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static BaseType_t prvPreemptsCurrentTask_EDF( const TCB_t * const pxTCB )
+	{
+	BaseType_t xReturn;
+
+		/* The heap is not consulted as a task readied while the scheduler is
+		suspended is not in it yet.  A task without timing parameters has a
+		deadline of 0 so preempts any task with a deadline in the same band.
+		Any task preempts the idle task, which runs in the background. */
+		if( pxCurrentTCB == ( TCB_t * ) xIdleTaskHandle )
+		{
+			xReturn = pdTRUE;
+		}
+		#if ( configUSE_EDF_PRIORITY_BANDS == 1 )
+		else if( pxTCB->uxPriority != pxCurrentTCB->uxPriority )
+		{
+			xReturn = ( pxTCB->uxPriority > pxCurrentTCB->uxPriority ) ? pdTRUE : pdFALSE;
+		}
+		#endif /* configUSE_EDF_PRIORITY_BANDS */
+		else if( taskSCHEDULING_KEY_EDF( pxTCB ) < taskSCHEDULING_KEY_EDF( pxCurrentTCB ) )
+		{
+			xReturn = pdTRUE;
+
+			#if ( configUSE_SRP_MUTEXES == 1 )
+			{
+				/* Switching to a job that would be held back by the system
+				ceiling would only switch straight back. */
+				if( taskIS_HELD_BY_CEILING_SRP( pxTCB ) )
+				{
+					xReturn = pdFALSE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_SRP_MUTEXES */
+
+			#if ( configUSE_EDF_LIMITED_PREEMPTION == 1 )
+			{
+				/* The floating non-preemptive region of the running task
+				starts here, where the preemption is first detected, so no
+				yield is requested until the tick ends the region. */
+				if( ( xReturn != pdFALSE ) &&
+					( pxCurrentTCB->xNonPreemptiveRegion != ( TickType_t ) 0U ) &&
+					( taskIS_IN_READY_LIST( pxCurrentTCB, pxCurrentTCB->uxPriority ) != pdFALSE ) )
+				{
+					if( pxCurrentTCB->ucPreemptionDeferred == pdFALSE )
+					{
+						pxCurrentTCB->ucPreemptionDeferred = pdTRUE;
+						pxCurrentTCB->xNonPreemptiveTicksLeft = pxCurrentTCB->xNonPreemptiveRegion;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					if( pxCurrentTCB->xNonPreemptiveTicksLeft != ( TickType_t ) 0U )
+					{
+						xReturn = pdFALSE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_EDF_LIMITED_PREEMPTION */
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static TCB_t *prvEarliestReadiedTask_EDF( TCB_t *pxEarliestTCB, TCB_t *pxTCB )
+	{
+		/* If any task of the batch preempts the running task then so does the
+		earliest of those that can start, as the other tests made by
+		prvPreemptsCurrentTask_EDF() only depend on the running task. */
+		if( taskIS_HELD_BY_CEILING_SRP( pxTCB ) )
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+		else if( ( pxEarliestTCB == NULL ) || ( taskRUNS_BEFORE_EDF( pxTCB, pxEarliestTCB ) ) )
+		{
+			pxEarliestTCB = pxTCB;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxEarliestTCB;
+	}
+	/*-----------------------------------------------------------*/
+
+	static DeadlineHeap_t *prvGetReadyHeapToRun_EDF( void )
+	{
+	DeadlineHeap_t *pxReadyHeap;
+
+		#if ( configUSE_EDF_PRIORITY_BANDS == 1 )
+		{
+		UBaseType_t uxTopPriority;
+
+			/* Find the highest priority band that contains ready tasks, in
+			the same way as taskSELECT_HIGHEST_PRIORITY_TASK().  Unlike the
+			ready lists the lowest band may be empty, as the idle task is not
+			in it. */
+			#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+			{
+				uxTopPriority = uxTopReadyPriority;
+
+				while( ( heapHEAP_IS_EMPTY( &( xReadyTasksHeapsEDF[ uxTopPriority ] ) ) != pdFALSE ) &&
+					   ( uxTopPriority > ( UBaseType_t ) tskIDLE_PRIORITY ) )
+				{
+					--uxTopPriority;
+				}
+
+				uxTopReadyPriority = uxTopPriority;
+			}
+			#else
+			{
+				if( uxTopReadyPriority != ( UBaseType_t ) 0 )
+				{
+					portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );
+				}
+				else
+				{
+					uxTopPriority = ( UBaseType_t ) tskIDLE_PRIORITY;
+				}
+			}
+			#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+			pxReadyHeap = &( xReadyTasksHeapsEDF[ uxTopPriority ] );
+		}
+		#else
+		{
+			pxReadyHeap = &xReadyTasksHeapEDF;
+		}
+		#endif /* configUSE_EDF_PRIORITY_BANDS */
+
+		if( heapHEAP_IS_EMPTY( pxReadyHeap ) != pdFALSE )
+		{
+			pxReadyHeap = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxReadyHeap;
+	}
+	/*-----------------------------------------------------------*/
+
+	static TCB_t *prvGetTaskToRun_EDF( void )
+	{
+	DeadlineHeap_t * const pxReadyHeap = prvGetReadyHeapToRun_EDF();
+	TCB_t *pxTCB;
+
+		if( pxReadyHeap != NULL )
+		{
+			pxTCB = ( TCB_t * ) heapGET_OWNER_OF_HEAD_ITEM( pxReadyHeap );
+		}
+		else
+		{
+			/* Before the scheduler is started a task has always just been
+			added to a ready heap, so the idle task handle is set by the
+			time this can be reached. */
+			configASSERT( xIdleTaskHandle );
+			pxTCB = ( TCB_t * ) xIdleTaskHandle;
+		}
+
+		return pxTCB;
+	}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_LIMITED_PREEMPTION == 1 ) )
+
+	static TCB_t *prvLimitPreemption_EDF( TCB_t *pxRunningTCB, TCB_t *pxEarliestTCB )
+	{
+	TCB_t *pxTCB = pxEarliestTCB;
+
+		if( pxEarliestTCB == pxRunningTCB )
+		{
+			/* Nothing is waiting to preempt the running task, so a region it
+			was executing has served its purpose. */
+			pxRunningTCB->ucPreemptionDeferred = pdFALSE;
+		}
+		else if( ( pxRunningTCB->xNonPreemptiveRegion != ( TickType_t ) 0U ) &&
+				 ( taskIS_IN_READY_LIST( pxRunningTCB, pxRunningTCB->uxPriority ) != pdFALSE ) )
+		{
+			/* The region is floating - it starts when a job with an earlier
+			deadline first tries to preempt the running job.  That is normally
+			detected by prvPreemptsCurrentTask_EDF(), but a switch requested
+			for another reason, such as a CBS replenishment, can reach here
+			first. */
+			if( pxRunningTCB->ucPreemptionDeferred == pdFALSE )
+			{
+				pxRunningTCB->ucPreemptionDeferred = pdTRUE;
+				pxRunningTCB->xNonPreemptiveTicksLeft = pxRunningTCB->xNonPreemptiveRegion;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( pxRunningTCB->xNonPreemptiveTicksLeft != ( TickType_t ) 0U )
+			{
+				pxTCB = pxRunningTCB;
+			}
+			else
+			{
+				/* The region is over, so the running task is preempted. */
+				pxRunningTCB->ucPreemptionDeferred = pdFALSE;
+			}
+		}
+		else
+		{
+			/* The running task has blocked, or cannot defer preemption. */
+			pxRunningTCB->ucPreemptionDeferred = pdFALSE;
+		}
+
+		return pxTCB;
+	}
+
+#endif /* configUSE_EDF_SCHEDULER && configUSE_EDF_LIMITED_PREEMPTION */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_SRP_MUTEXES == 1 ) )
+
+	static void prvApplySystemCeiling_SRP( void )
+	{
+	TCB_t *pxTCB;
+	DeadlineHeap_t *pxReadyHeap;
+
+		for( ;; )
+		{
+			pxReadyHeap = prvGetReadyHeapToRun_EDF();
+
+			if( pxReadyHeap == NULL )
+			{
+				/* Every ready job is held back, so the idle task runs until
+				the ceiling is lowered. */
+				break;
+			}
+
+			pxTCB = ( TCB_t * ) heapGET_OWNER_OF_HEAD_ITEM( pxReadyHeap );
+
+			if( taskIS_HELD_BY_CEILING_SRP( pxTCB ) == pdFALSE )
+			{
+				break;
+			}
+
+			if( uxDeadlineHeapRemove( &( pxTCB->xStateHeapItem ) ) == ( UBaseType_t ) 0 )
+			{
+				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			vDeadlineHeapInsert( &xCeilingBlockedHeapSRP, &( pxTCB->xStateHeapItem ) );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	TickType_t xTaskRaiseSystemCeiling_SRP( TickType_t xCeiling )
+	{
+	TickType_t xPreviousCeiling = xSystemCeilingSRP;
+
+		/* Called from a critical section by the task taking the mutex.  The
+		task that is running has always started its job, so raising the
+		ceiling never requires a context switch. */
+		if( xCeiling < xSystemCeilingSRP )
+		{
+			xSystemCeilingSRP = xCeiling;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xPreviousCeiling;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xTaskRestoreSystemCeiling_SRP( TickType_t xPreviousCeiling )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xReturn = pdFALSE;
+
+		/* Called from a critical section by the task giving the mutex. */
+		xSystemCeilingSRP = xPreviousCeiling;
+
+		/* The jobs held back are returned to the ready heap, and those that
+		are still not above the ceiling are held back again the next time a
+		task is selected to run. */
+		while( heapHEAP_IS_EMPTY( &xCeilingBlockedHeapSRP ) == pdFALSE )
+		{
+			pxTCB = ( TCB_t * ) heapGET_OWNER_OF_HEAD_ITEM( &xCeilingBlockedHeapSRP );
+			( void ) uxDeadlineHeapRemove( &( pxTCB->xStateHeapItem ) );
+			taskRECORD_READY_PRIORITY( pxTCB->uxPriority );
+			vDeadlineHeapInsert( taskREADY_HEAP_EDF( pxTCB->uxPriority ), &( pxTCB->xStateHeapItem ) );
+		}
+
+		if( pxCurrentTCB != NULL )
+		{
+			if( prvGetTaskToRun_EDF() != pxCurrentTCB )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EDF_SCHEDULER && configUSE_SRP_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_ADMISSION_CONTROL == 1 ) )
+
+	/* Macros used to derive the contribution of one task to the admission
+	state.  The same values are added when the task is admitted and subtracted
+	when it is deleted. */
+	#define taskADMISSION_FIXED_POINT_ONE	( ( uint64_t ) 1ULL << 20 )
+	#define taskADMISSION_DENSITY( xWCET, xPeriod, xDeadline )															\
+		( ( ( ( uint64_t ) ( xWCET ) * taskADMISSION_FIXED_POINT_ONE ) +												\
+			( ( ( xDeadline ) < ( xPeriod ) ? ( xDeadline ) : ( xPeriod ) ) - 1U ) ) /									\
+			( ( xDeadline ) < ( xPeriod ) ? ( xDeadline ) : ( xPeriod ) ) )
+	#define taskADMISSION_SLACK_DEMAND( xWCET, xPeriod, xDeadline )														\
+		( ( ( xDeadline ) < ( xPeriod ) ) ?																				\
+			( ( ( ( uint64_t ) ( ( xPeriod ) - ( xDeadline ) ) * ( xWCET ) ) + ( ( xPeriod ) - 1U ) ) / ( xPeriod ) ) :	\
+			0ULL )
+
+	/* The fixed value a task is ordered by under rate or deadline monotonic
+	ordering, as taskSCHEDULING_KEY_EDF(). */
+	#if ( configEDF_SCHEDULING_POLICY == edfPOLICY_RM )
+		#define taskADMISSION_FIXED_KEY( xPeriod, xDeadline )	( ( void ) ( xDeadline ), ( xPeriod ) )
+	#elif ( configEDF_SCHEDULING_POLICY == edfPOLICY_DM )
+		#define taskADMISSION_FIXED_KEY( xPeriod, xDeadline )	( ( void ) ( xPeriod ), ( xDeadline ) )
+	#endif
+
+	static uint64_t prvGreatestCommonDivisor( uint64_t ullA, uint64_t ullB )
+	{
+	uint64_t ullRemainder;
+
+		while( ullB != 0ULL )
+		{
+			ullRemainder = ullA % ullB;
+			ullA = ullB;
+			ullB = ullRemainder;
+		}
+
+		return ullA;
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint64_t prvProcessorDemand_EDF( uint64_t xTime, TickType_t xWCET, TickType_t xPeriod, TickType_t xDeadline )
+	{
+	const ListItem_t *pxItem;
+	const ListItem_t * const pxEnd = listGET_END_MARKER( &xAdmittedTasksListEDF );
+	TCB_t *pxTCB;
+	uint64_t ullDemand = 0ULL;
+
+		/* The demand of a task over [ 0, t ] is the execution time of every
+		job with both its release and its deadline in the interval. */
+		if( xTime >= xDeadline )
+		{
+			ullDemand += ( ( ( xTime - xDeadline ) / xPeriod ) + 1ULL ) * xWCET;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		for( pxItem = listGET_HEAD_ENTRY( &xAdmittedTasksListEDF ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+		{
+			pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+
+			if( xTime >= pxTCB->xTaskDeadline )
+			{
+				ullDemand += ( ( ( xTime - pxTCB->xTaskDeadline ) / pxTCB->xTaskPeriod ) + 1ULL ) * pxTCB->xTaskWCET;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return ullDemand;
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint64_t prvLastDeadlineBefore_EDF( uint64_t xTime, TickType_t xPeriod, TickType_t xDeadline )
+	{
+	const ListItem_t *pxItem;
+	const ListItem_t * const pxEnd = listGET_END_MARKER( &xAdmittedTasksListEDF );
+	TCB_t *pxTCB;
+	uint64_t ullLast = 0ULL, ullDeadline;
+
+		if( xTime > xDeadline )
+		{
+			ullLast = ( ( ( xTime - xDeadline - 1ULL ) / xPeriod ) * xPeriod ) + xDeadline;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		for( pxItem = listGET_HEAD_ENTRY( &xAdmittedTasksListEDF ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+		{
+			pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+
+			if( xTime > pxTCB->xTaskDeadline )
+			{
+				ullDeadline = ( ( ( xTime - pxTCB->xTaskDeadline - 1ULL ) / pxTCB->xTaskPeriod ) * pxTCB->xTaskPeriod ) + pxTCB->xTaskDeadline;
+
+				if( ullDeadline > ullLast )
+				{
+					ullLast = ullDeadline;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return ullLast;
+	}
+	/*-----------------------------------------------------------*/
+
+	#if ( ( configEDF_SCHEDULING_POLICY == edfPOLICY_RM ) || ( configEDF_SCHEDULING_POLICY == edfPOLICY_DM ) )
+
+		static BaseType_t prvMeetsDeadline_EDF( const TCB_t * const pxTCB, TickType_t xWCET, TickType_t xKey, TickType_t xDeadline, TickType_t xNewWCET, TickType_t xNewPeriod, TickType_t xNewDeadline )
+		{
+		const ListItem_t *pxItem;
+		const ListItem_t * const pxEnd = listGET_END_MARKER( &xAdmittedTasksListEDF );
+		const TCB_t *pxOtherTCB;
+		uint64_t ullResponse = xWCET, ullPrevious;
+
+			/* Iterate R = C + sum( ceil( R / Tj ) * Cj ) over the tasks that can
+			run before the job to its fixed point, or until it passes the
+			deadline.  The order between tasks with the same value is not
+			fixed, so they are counted as running first. */
+			do
+			{
+				ullPrevious = ullResponse;
+				ullResponse = xWCET;
+
+				if( ( pxTCB != NULL ) && ( taskADMISSION_FIXED_KEY( xNewPeriod, xNewDeadline ) <= xKey ) )
+				{
+					ullResponse += ( ( ullPrevious + xNewPeriod - 1ULL ) / xNewPeriod ) * xNewWCET;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				for( pxItem = listGET_HEAD_ENTRY( &xAdmittedTasksListEDF ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+				{
+					pxOtherTCB = ( const TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+
+					if( ( pxOtherTCB != pxTCB ) && ( taskADMISSION_FIXED_KEY( pxOtherTCB->xTaskPeriod, pxOtherTCB->xTaskDeadline ) <= xKey ) )
+					{
+						ullResponse += ( ( ullPrevious + pxOtherTCB->xTaskPeriod - 1ULL ) / pxOtherTCB->xTaskPeriod ) * pxOtherTCB->xTaskWCET;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			} while( ( ullResponse != ullPrevious ) && ( ullResponse <= ( uint64_t ) xDeadline ) );
+
+			return ( ullResponse <= ( uint64_t ) xDeadline ) ? pdTRUE : pdFALSE;
+		}
+		/*-----------------------------------------------------------*/
+
+		static BaseType_t prvResponseTimeTest_EDF( TickType_t xWCET, TickType_t xPeriod, TickType_t xDeadline )
+		{
+		const ListItem_t *pxItem;
+		const ListItem_t * const pxEnd = listGET_END_MARKER( &xAdmittedTasksListEDF );
+		const TCB_t *pxTCB;
+		const TickType_t xKey = taskADMISSION_FIXED_KEY( xPeriod, xDeadline );
+		BaseType_t xReturn;
+
+			xReturn = prvMeetsDeadline_EDF( NULL, xWCET, xKey, xDeadline, xWCET, xPeriod, xDeadline );
+
+			for( pxItem = listGET_HEAD_ENTRY( &xAdmittedTasksListEDF ); ( xReturn != pdFALSE ) && ( pxItem != pxEnd ); pxItem = listGET_NEXT( pxItem ) )
+			{
+				pxTCB = ( const TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+
+				/* Only the tasks that may run after the new task are delayed
+				by it.  The others passed when they were admitted. */
+				if( taskADMISSION_FIXED_KEY( pxTCB->xTaskPeriod, pxTCB->xTaskDeadline ) >= xKey )
+				{
+					xReturn = prvMeetsDeadline_EDF( pxTCB, pxTCB->xTaskWCET, taskADMISSION_FIXED_KEY( pxTCB->xTaskPeriod, pxTCB->xTaskDeadline ), pxTCB->xTaskDeadline, xWCET, xPeriod, xDeadline );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			return xReturn;
+		}
+		/*-----------------------------------------------------------*/
+
+	#endif /* configEDF_SCHEDULING_POLICY */
+
+	static BaseType_t prvAdmitTask_EDF( TCB_t *pxTCB, TickType_t xWCET, TickType_t xPeriod, TickType_t xDeadline )
+	{
+	const ListItem_t *pxItem;
+	const ListItem_t * const pxEnd = listGET_END_MARKER( &xAdmittedTasksListEDF );
+	TCB_t *pxAdmittedTCB;
+	uint64_t ullNumerator, ullDenominator, ullDivisor, ullLimit, ullTime, ullDemand, ullPrevious;
+	uint64_t ullDensity;
+	TickType_t xMinDeadline = xDeadline, xMaxDeadline = xDeadline;
+	BaseType_t xReturn;
+
+		configASSERT( xPeriod > ( TickType_t ) 0U );
+
+		if( listLIST_IS_INITIALISED( &xAdmittedTasksListEDF ) == pdFALSE )
+		{
+			vListInitialise( &xAdmittedTasksListEDF );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* A task that declares no execution time places no demand on the
+		processor, so is always admitted and is not analysed. */
+		if( xWCET == ( TickType_t ) 0U )
+		{
+			return pdTRUE;
+		}
+		else if( xWCET > xDeadline )
+		{
+			/* A job could not complete by its deadline even if it ran alone. */
+			return pdFALSE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Add C / T to the utilisation exactly, as a fraction whose
+		denominator is a multiple of the admitted periods.  A utilisation of
+		exactly one is schedulable when D = T, so rounding here could reject a
+		schedulable set. */
+		ullDivisor = prvGreatestCommonDivisor( ullAdmittedUtilisationDenominator, xPeriod );
+		ullLimit = ~0ULL / ( xPeriod / ullDivisor );
+
+		if( ( ullAdmittedUtilisationDenominator > ullLimit ) || ( ullAdmittedUtilisationNumerator > ullLimit ) )
+		{
+			/* The periods are too far from being harmonic for the utilisation
+			to be held exactly.  Reject the task rather than risk admitting an
+			unschedulable set. */
+			return pdFALSE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		ullDenominator = ullAdmittedUtilisationDenominator * ( xPeriod / ullDivisor );
+		ullNumerator = ( ullAdmittedUtilisationNumerator * ( xPeriod / ullDivisor ) ) + ( ( uint64_t ) xWCET * ( ullAdmittedUtilisationDenominator / ullDivisor ) );
+
+		if( ullNumerator > ullDenominator )
+		{
+			/* U > 1. */
+			return pdFALSE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if ( ( configEDF_SCHEDULING_POLICY == edfPOLICY_RM ) || ( configEDF_SCHEDULING_POLICY == edfPOLICY_DM ) )
+		{
+			/* The tests below hold only when jobs are ordered by deadline.
+			Under a fixed ordering each task must also complete within its
+			deadline when released together with every task ordered before it.
+			A set that passes meets its deadlines under EDF as well, so the
+			tests below then admit it and update the admission state. */
+			if( prvResponseTimeTest_EDF( xWCET, xPeriod, xDeadline ) == pdFALSE )
+			{
+				return pdFALSE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		ullDensity = ullAdmittedDensity + taskADMISSION_DENSITY( xWCET, xPeriod, xDeadline );
+
+		if( ullDensity <= taskADMISSION_FIXED_POINT_ONE )
+		{
+			/* The sum of C / min( D, T ) not exceeding one is sufficient for
+			the set to be schedulable. */
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			for( pxItem = listGET_HEAD_ENTRY( &xAdmittedTasksListEDF ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+			{
+				pxAdmittedTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+
+				if( pxAdmittedTCB->xTaskDeadline < xMinDeadline )
+				{
+					xMinDeadline = pxAdmittedTCB->xTaskDeadline;
+				}
+				else if( pxAdmittedTCB->xTaskDeadline > xMaxDeadline )
+				{
+					xMaxDeadline = pxAdmittedTCB->xTaskDeadline;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			/* Find an interval length beyond which the demand cannot exceed
+			the time available.  When U < 1 this is
+			La = max( Dmax, sum( ( T - D ) * U ) / ( 1 - U ) ).  When U = 1, or
+			La cannot be computed without overflow, the length of the
+			synchronous busy period is used instead. */
+			ullDemand = ullAdmittedSlackDemand + taskADMISSION_SLACK_DEMAND( xWCET, xPeriod, xDeadline );
+
+			if( ( ullNumerator < ullDenominator ) && ( ullDemand <= ( ~0ULL / ullDenominator ) ) )
+			{
+				ullLimit = ( ( ullDemand * ullDenominator ) + ( ullDenominator - ullNumerator - 1ULL ) ) / ( ullDenominator - ullNumerator );
+
+				if( ullLimit < ( uint64_t ) xMaxDeadline )
+				{
+					ullLimit = ( uint64_t ) xMaxDeadline;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Iterate w = sum( ceil( w / T ) * C ) to its fixed point, which
+				exists as U <= 1. */
+				ullLimit = xWCET;
+
+				for( pxItem = listGET_HEAD_ENTRY( &xAdmittedTasksListEDF ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+				{
+					ullLimit += ( ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem ) )->xTaskWCET;
+				}
+
+				do
+				{
+					ullPrevious = ullLimit;
+					ullLimit = ( ( ullPrevious + xPeriod - 1ULL ) / xPeriod ) * xWCET;
+
+					for( pxItem = listGET_HEAD_ENTRY( &xAdmittedTasksListEDF ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+					{
+						pxAdmittedTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+						ullLimit += ( ( ullPrevious + pxAdmittedTCB->xTaskPeriod - 1ULL ) / pxAdmittedTCB->xTaskPeriod ) * pxAdmittedTCB->xTaskWCET;
 					}
-				}
-				( void ) xTaskResumeAll();
+				} while( ullLimit != ullPrevious );
 			}
-			else
+
+			/* QPA (Zhang and Burns).  Start from the last deadline in the
+			interval and step backwards, jumping straight to h( t ) whenever the
+			demand is below t, until either the demand exceeds the time
+			available or falls to the earliest deadline. */
+			ullTime = prvLastDeadlineBefore_EDF( ullLimit + 1ULL, xPeriod, xDeadline );
+			ullDemand = prvProcessorDemand_EDF( ullTime, xWCET, xPeriod, xDeadline );
+
+			while( ( ullDemand <= ullTime ) && ( ullDemand > ( uint64_t ) xMinDeadline ) )
 			{
-				mtCOVERAGE_TEST_MARKER();
+				if( ullDemand < ullTime )
+				{
+					ullTime = ullDemand;
+				}
+				else
+				{
+					ullTime = prvLastDeadlineBefore_EDF( ullTime, xPeriod, xDeadline );
+				}
+
+				ullDemand = prvProcessorDemand_EDF( ullTime, xWCET, xPeriod, xDeadline );
 			}
+
+			xReturn = ( ullDemand <= ( uint64_t ) xMinDeadline ) ? pdTRUE : pdFALSE;
 		}
-		#endif /* configUSE_TICKLESS_IDLE */
+
+		if( xReturn != pdFALSE )
+		{
+			ullDivisor = prvGreatestCommonDivisor( ullNumerator, ullDenominator );
+			ullAdmittedUtilisationNumerator = ullNumerator / ullDivisor;
+			ullAdmittedUtilisationDenominator = ullDenominator / ullDivisor;
+			ullAdmittedDensity = ullDensity;
+			ullAdmittedSlackDemand += taskADMISSION_SLACK_DEMAND( xWCET, xPeriod, xDeadline );
+
+			/* The timing parameters are copied into the TCB by the caller
+			before the scheduler is resumed. */
+			vListInsertEnd( &xAdmittedTasksListEDF, &( pxTCB->xAdmissionListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
 	}
-}
+	/*-----------------------------------------------------------*/
+
+	static void prvWithdrawTask_EDF( TCB_t *pxTCB )
+	{
+	uint64_t ullDivisor, ullNumerator, ullDenominator;
+
+		( void ) uxListRemove( &( pxTCB->xAdmissionListItem ) );
+
+		/* The utilisation is held in lowest terms, so the denominator need
+		not be a multiple of the period of the task.  Bring both fractions to
+		their common denominator before subtracting C / T.  That denominator
+		was representable when the task was admitted, so it cannot overflow
+		now. */
+		ullDivisor = prvGreatestCommonDivisor( ullAdmittedUtilisationDenominator, pxTCB->xTaskPeriod );
+		ullDenominator = ullAdmittedUtilisationDenominator * ( pxTCB->xTaskPeriod / ullDivisor );
+		ullNumerator = ( ullAdmittedUtilisationNumerator * ( pxTCB->xTaskPeriod / ullDivisor ) ) - ( ( uint64_t ) pxTCB->xTaskWCET * ( ullAdmittedUtilisationDenominator / ullDivisor ) );
+		ullDivisor = prvGreatestCommonDivisor( ullNumerator, ullDenominator );
+		ullAdmittedUtilisationNumerator = ullNumerator / ullDivisor;
+		ullAdmittedUtilisationDenominator = ullDenominator / ullDivisor;
+
+		ullAdmittedDensity -= taskADMISSION_DENSITY( pxTCB->xTaskWCET, pxTCB->xTaskPeriod, pxTCB->xTaskDeadline );
+		ullAdmittedSlackDemand -= taskADMISSION_SLACK_DEMAND( pxTCB->xTaskWCET, pxTCB->xTaskPeriod, pxTCB->xTaskDeadline );
+	}
+
+#endif /* configUSE_EDF_SCHEDULER && configUSE_EDF_ADMISSION_CONTROL */
 /*-----------------------------------------------------------*/
 
-#if( configUSE_TICKLESS_IDLE != 0 )
+#if ( configUSE_EDF_SCHEDULER == 1 )
 
-	eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+	static BaseType_t prvSetPeriod_EDF( TCB_t *pxTCB, TickType_t xPeriod )
 	{
-	/* The idle task exists in addition to the application tasks. */
-	const UBaseType_t uxNonApplicationTasks = 1;
-	eSleepModeStatus eReturn = eStandardSleep;
+	TickType_t xDeadline = pxTCB->xTaskDeadline;
+	BaseType_t xIsReady;
 
-		if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
+		if( xDeadline == pxTCB->xTaskPeriod )
 		{
-			/* A task was made ready while the scheduler was suspended. */
-			eReturn = eAbortSleep;
+			xDeadline = xPeriod;
 		}
-		else if( xYieldPending != pdFALSE )
+		else
 		{
-			/* A yield was pended while the scheduler was suspended. */
-			eReturn = eAbortSleep;
+			mtCOVERAGE_TEST_MARKER();
 		}
-		else
+
+		#if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
 		{
-			/* If all the tasks are in the suspended list (which might mean they
-			have an infinite block time rather than actually being suspended)
-			then it is safe to turn all clocks off and just wait for external
-			interrupts. */
-			if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+			if( listLIST_ITEM_CONTAINER( &( pxTCB->xAdmissionListItem ) ) != NULL )
 			{
-				eReturn = eNoTasksWaitingTimeout;
+				prvWithdrawTask_EDF( pxTCB );
+
+				if( prvAdmitTask_EDF( pxTCB, pxTCB->xTaskWCET, xPeriod, xDeadline ) == pdFALSE )
+				{
+					/* The tasks were schedulable with the old period, so the
+					task is admitted again with it. */
+					xIsReady = prvAdmitTask_EDF( pxTCB, pxTCB->xTaskWCET, pxTCB->xTaskPeriod, pxTCB->xTaskDeadline );
+					configASSERT( xIsReady );
+					return pdFALSE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
+		#endif /* configUSE_EDF_ADMISSION_CONTROL */
 
-		return eReturn;
-	}
-
-#endif /* configUSE_TICKLESS_IDLE */
-/*-----------------------------------------------------------*/
+		/* Under RM and DM the period or deadline is the ready heap key, so it
+		cannot change while the task is in the heap. */
+		xIsReady = taskIS_IN_READY_LIST( pxTCB, pxTCB->uxPriority );
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+		if( xIsReady != pdFALSE )
+		{
+			( void ) uxDeadlineHeapRemove( &( pxTCB->xStateHeapItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-	void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue )
-	{
-	TCB_t *pxTCB;
+		pxTCB->xTaskPeriod = xPeriod;
+		pxTCB->xTaskDeadline = xDeadline;
 
-		if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+		if( xIsReady != pdFALSE )
 		{
-			pxTCB = prvGetTCBFromHandle( xTaskToSet );
-			pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+			heapSET_HEAP_ITEM_VALUE( &( pxTCB->xStateHeapItem ), taskSCHEDULING_KEY_EDF( pxTCB ) );
+			vDeadlineHeapInsert( taskREADY_HEAP_EDF( pxTCB->uxPriority ), &( pxTCB->xStateHeapItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
 		}
+
+		return pdTRUE;
 	}
 
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+#endif /* configUSE_EDF_SCHEDULER */
 /*-----------------------------------------------------------*/
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_ELASTIC_TASKS == 1 ) )
 
-	void *pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery, BaseType_t xIndex )
+	/* Utilisations are held in fixed point so the manager needs no floating
+	point.  A task without a WCET or an elastic coefficient is never
+	stretched. */
+	#define taskELASTIC_FIXED_POINT_ONE		( ( uint64_t ) 1ULL << 20 )
+	#define taskELASTIC_UTILISATION( pxTCB, xPeriod )	( ( ( uint64_t ) ( pxTCB )->xTaskWCET * taskELASTIC_FIXED_POINT_ONE ) / ( xPeriod ) )
+	#define taskELASTIC_IS_RIGID( pxTCB )	( ( ( pxTCB )->uxElasticity == ( UBaseType_t ) 0U ) || ( ( pxTCB )->xTaskWCET == ( TickType_t ) 0U ) || ( ( pxTCB )->xNominalPeriod == ( pxTCB )->xMaxPeriod ) )
+
+	static BaseType_t prvCompressPeriods_EDF( void )
 	{
-	void *pvReturn = NULL;
+	const ListItem_t *pxItem;
+	const ListItem_t * const pxEnd = listGET_END_MARKER( &xElasticTasksListEDF );
 	TCB_t *pxTCB;
+	const uint64_t ullTarget = ( ( uint64_t ) configEDF_ELASTIC_UTILISATION * taskELASTIC_FIXED_POINT_ONE ) / 100ULL;
+	uint64_t ullFixed, ullVariable, ullElasticity, ullExcess, ullUtilisation;
+	BaseType_t xNewlyFixed, xPass;
+	TickType_t xPeriod;
 
-		if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
-		{
-			pxTCB = prvGetTCBFromHandle( xTaskToQuery );
-			pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
-		}
-		else
+		/* Rigid tasks keep their nominal period. */
+		for( pxItem = listGET_HEAD_ENTRY( &xElasticTasksListEDF ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
 		{
-			pvReturn = NULL;
+			pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+			pxTCB->ucElasticFixed = taskELASTIC_IS_RIGID( pxTCB ) ? pdTRUE : pdFALSE;
 		}
 
-		return pvReturn;
-	}
+		/* Buttazzo's elastic compression.  The excess utilisation is shared
+		between the tasks that can still be stretched in proportion to their
+		elastic coefficients.  A task that would be stretched beyond its
+		maximum period is fixed at that period, and the excess shared again
+		between the others, until no more tasks reach their maximum. */
+		do
+		{
+			ullFixed = 0ULL;
+			ullVariable = 0ULL;
+			ullElasticity = 0ULL;
 
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
-/*-----------------------------------------------------------*/
+			for( pxItem = listGET_HEAD_ENTRY( &xElasticTasksListEDF ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+			{
+				pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
 
-#if ( portUSING_MPU_WRAPPERS == 1 )
+				if( pxTCB->ucElasticFixed == pdFALSE )
+				{
+					ullVariable += taskELASTIC_UTILISATION( pxTCB, pxTCB->xNominalPeriod );
+					ullElasticity += pxTCB->uxElasticity;
+				}
+				else if( taskELASTIC_IS_RIGID( pxTCB ) )
+				{
+					ullFixed += taskELASTIC_UTILISATION( pxTCB, pxTCB->xNominalPeriod );
+				}
+				else
+				{
+					ullFixed += taskELASTIC_UTILISATION( pxTCB, pxTCB->xMaxPeriod );
+				}
+			}
 
-	void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify, const MemoryRegion_t * const xRegions )
-	{
-	TCB_t *pxTCB;
+			if( ( ullFixed + ullVariable <= ullTarget ) || ( ullElasticity == 0ULL ) )
+			{
+				/* Either there is no overload, or every task that could
+				absorb it is already at its maximum period. */
+				ullExcess = 0ULL;
+				break;
+			}
+			else
+			{
+				ullExcess = ullFixed + ullVariable - ullTarget;
+			}
 
-		/* If null is passed in here then we are modifying the MPU settings of
-		the calling task. */
-		pxTCB = prvGetTCBFromHandle( xTaskToModify );
+			xNewlyFixed = pdFALSE;
 
-		vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
-	}
+			for( pxItem = listGET_HEAD_ENTRY( &xElasticTasksListEDF ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+			{
+				pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
 
-#endif /* portUSING_MPU_WRAPPERS */
-/*-----------------------------------------------------------*/
+				if( pxTCB->ucElasticFixed == pdFALSE )
+				{
+					if( taskELASTIC_UTILISATION( pxTCB, pxTCB->xNominalPeriod ) <= ( ( ullExcess * pxTCB->uxElasticity ) / ullElasticity ) + taskELASTIC_UTILISATION( pxTCB, pxTCB->xMaxPeriod ) )
+					{
+						pxTCB->ucElasticFixed = pdTRUE;
+						xNewlyFixed = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		} while( xNewlyFixed != pdFALSE );
 
-static void prvInitialiseTaskLists( void )
-{
-	// UBaseType_t uxPriority;
-	#if (configUSE_EDF_SCHEDULER == 1)
-	{
-		vListInitialise( &xReadyTasksListEDF );
-	}
-	#else
-	{
-		UBaseType_t uxPriority;
-		for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+		/* Apply the new periods.  Periods that are lengthened are changed
+		first so that, under admission control, the utilisation they free is
+		available to the periods that are shortened. */
+		for( xPass = 0; xPass < 2; xPass++ )
 		{
-			vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+			for( pxItem = listGET_HEAD_ENTRY( &xElasticTasksListEDF ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+			{
+				pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+
+				if( taskELASTIC_IS_RIGID( pxTCB ) || ( ( pxTCB->ucElasticFixed == pdFALSE ) && ( ullExcess == 0ULL ) ) )
+				{
+					xPeriod = pxTCB->xNominalPeriod;
+				}
+				else if( pxTCB->ucElasticFixed != pdFALSE )
+				{
+					xPeriod = pxTCB->xMaxPeriod;
+				}
+				else
+				{
+					/* T = C / U, rounded up so the task uses no more than its
+					share. */
+					ullUtilisation = taskELASTIC_UTILISATION( pxTCB, pxTCB->xNominalPeriod ) - ( ( ullExcess * pxTCB->uxElasticity ) / ullElasticity );
+					xPeriod = ( TickType_t ) ( ( ( ( uint64_t ) pxTCB->xTaskWCET * taskELASTIC_FIXED_POINT_ONE ) + ullUtilisation - 1ULL ) / ullUtilisation );
+
+					if( xPeriod > pxTCB->xMaxPeriod )
+					{
+						xPeriod = pxTCB->xMaxPeriod;
+					}
+					else if( xPeriod < pxTCB->xNominalPeriod )
+					{
+						xPeriod = pxTCB->xNominalPeriod;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				if( ( ( xPass == 0 ) && ( xPeriod > pxTCB->xTaskPeriod ) ) ||
+					( ( xPass != 0 ) && ( xPeriod < pxTCB->xTaskPeriod ) ) )
+				{
+					if( prvSetPeriod_EDF( pxTCB, xPeriod ) == pdFALSE )
+					{
+						return pdFALSE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
 		}
+
+		return pdTRUE;
 	}
-	#endif
+	/*-----------------------------------------------------------*/
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
-	vListInitialise( &xPendingReadyList );
+	#if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
 
-	#if (configUSE_EDF_SCHEDULER == 1)
-	{
-		vListInitialise( &xReadyTasksListEDF );
-	}
-	#endif
-	#if ( INCLUDE_vTaskDelete == 1 )
-	{
-		vListInitialise( &xTasksWaitingTermination );
-	}
-	#endif /* INCLUDE_vTaskDelete */
+		static BaseType_t prvAdmitByCompression_EDF( TCB_t *pxNewTCB, TickType_t xWCET, TickType_t xPeriod, TickType_t xDeadline )
+		{
+		BaseType_t xReturn;
 
-	#if ( INCLUDE_vTaskSuspend == 1 )
-	{
-		vListInitialise( &xSuspendedTaskList );
-	}
-	#endif /* INCLUDE_vTaskSuspend */
+			/* Only the fields the manager reads are set.  The new task is
+			rigid, so the manager never changes its period. */
+			pxNewTCB->xTaskWCET = xWCET;
+			pxNewTCB->xTaskPeriod = xPeriod;
+			pxNewTCB->xTaskDeadline = xDeadline;
+			pxNewTCB->xNominalPeriod = xPeriod;
+			pxNewTCB->xMaxPeriod = xPeriod;
+			pxNewTCB->uxElasticity = ( UBaseType_t ) 0U;
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
-}
+			vListInsertEnd( &xElasticTasksListEDF, &( pxNewTCB->xElasticListItem ) );
+			( void ) prvCompressPeriods_EDF();
+			( void ) uxListRemove( &( pxNewTCB->xElasticListItem ) );
+
+			xReturn = prvAdmitTask_EDF( pxNewTCB, xWCET, xPeriod, xDeadline );
+
+			if( xReturn == pdFALSE )
+			{
+				( void ) prvCompressPeriods_EDF();
+			}
+			else
+			{
+				/* The task is added to the elastic tasks list again once its
+				timing parameters have been set. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			return xReturn;
+		}
+
+	#endif /* configUSE_EDF_ADMISSION_CONTROL */
+
+#endif /* configUSE_EDF_SCHEDULER && configUSE_EDF_ELASTIC_TASKS */
 /*-----------------------------------------------------------*/
 
 static void prvCheckTasksWaitingTermination( void )
@@ -3979,9 +7402,9 @@ TCB_t *pxTCB;
 
 				/* If the task being modified is in the ready state it will need
 				to be moved into a new list. */
-				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+				if( taskIS_IN_READY_LIST( pxMutexHolderTCB, pxMutexHolderTCB->uxPriority ) != pdFALSE )
 				{
-					if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+					if( taskREMOVE_FROM_STATE_LIST( pxMutexHolderTCB ) == ( UBaseType_t ) 0 )
 					{
 						taskRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority );
 					}
@@ -4064,7 +7487,7 @@ TCB_t *pxTCB;
 					given from an interrupt, and if a mutex is given by the
 					holding task then it must be the running state task.  Remove
 					the holding task from the ready list. */
-					if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+					if( taskREMOVE_FROM_STATE_LIST( pxTCB ) == ( UBaseType_t ) 0 )
 					{
 						taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 					}
@@ -4180,9 +7603,9 @@ TCB_t *pxTCB;
 					from its current state list if it is in the Ready state as
 					the task's priority is going to change and there is one
 					Ready list per priority. */
-					if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+					if( taskIS_IN_READY_LIST( pxTCB, uxPriorityUsedOnEntry ) != pdFALSE )
 					{
-						if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+						if( taskREMOVE_FROM_STATE_LIST( pxTCB ) == ( UBaseType_t ) 0 )
 						{
 							taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 						}
@@ -4217,6 +7640,37 @@ TCB_t *pxTCB;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MUTEXES == 1 ) )
+
+	UBaseType_t uxTaskGetHighestWaitingPriority_EDF( const List_t * const pxEventList )
+	{
+	const ListItem_t *pxItem;
+	const ListItem_t * const pxEnd = listGET_END_MARKER( pxEventList );
+	const TCB_t *pxTCB;
+	UBaseType_t uxHighestPriority = tskIDLE_PRIORITY;
+
+		/* Called from a critical section.  The event list is ordered by
+		deadline rather than by priority, so every waiting task is checked. */
+		for( pxItem = listGET_HEAD_ENTRY( pxEventList ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+		{
+			pxTCB = ( const TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+
+			if( pxTCB->uxPriority > uxHighestPriority )
+			{
+				uxHighestPriority = pxTCB->uxPriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return uxHighestPriority;
+	}
+
+#endif /* configUSE_EDF_SCHEDULER && configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( portCRITICAL_NESTING_IN_TCB == 1 )
 
 	void vTaskEnterCritical( void )
@@ -4771,7 +8225,7 @@ TickType_t uxReturn;
 			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
 			{
 				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-				prvAddTaskToReadyList( pxTCB );
+				prvAddUnblockedTaskToReadyList( pxTCB );
 
 				/* The task should not have been on an event list. */
 				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
@@ -4792,7 +8246,7 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskHAS_PRIORITY_OVER_CURRENT( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4901,7 +8355,7 @@ TickType_t uxReturn;
 				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 				{
 					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-					prvAddTaskToReadyList( pxTCB );
+					prvAddUnblockedTaskToReadyList( pxTCB );
 				}
 				else
 				{
@@ -4910,7 +8364,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskHAS_PRIORITY_OVER_CURRENT( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4991,7 +8445,7 @@ TickType_t uxReturn;
 				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 				{
 					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-					prvAddTaskToReadyList( pxTCB );
+					prvAddUnblockedTaskToReadyList( pxTCB );
 				}
 				else
 				{
@@ -5000,7 +8454,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskHAS_PRIORITY_OVER_CURRENT( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5077,7 +8531,7 @@ const TickType_t xConstTickCount = xTickCount;
 
 	/* Remove the task from the ready list before adding it to the blocked list
 	as the same list item is used for both lists. */
-	if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+	if( taskREMOVE_FROM_STATE_LIST( pxCurrentTCB ) == ( UBaseType_t ) 0 )
 	{
 		/* The current task must be in a ready list, so there is no need to
 		check, and the port reset macro can be called directly. */
@@ -5104,9 +8558,25 @@ const TickType_t xConstTickCount = xTickCount;
 			kernel will manage it correctly. */
 			xTimeToWake = xConstTickCount + xTicksToWait;
 
+			#if( configUSE_64_BIT_TICKS == 1 )
+			{
+				/* The tick count itself never overflows, so only a block time
+				close to portMAX_DELAY can, and such a task is never woken. */
+				if( xTimeToWake < xConstTickCount )
+				{
+					xTimeToWake = portMAX_DELAY;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_64_BIT_TICKS */
+
 			/* The list item will be inserted in wake time order. */
 			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+			#if( configUSE_64_BIT_TICKS == 0 )
 			if( xTimeToWake < xConstTickCount )
 			{
 				/* Wake time has overflowed.  Place this item in the overflow
@@ -5114,6 +8584,7 @@ const TickType_t xConstTickCount = xTickCount;
 				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 			}
 			else
+			#endif /* configUSE_64_BIT_TICKS */
 			{
 				/* The wake time has not overflowed, so the current block list
 				is used. */
@@ -5140,15 +8611,32 @@ const TickType_t xConstTickCount = xTickCount;
 		will manage it correctly. */
 		xTimeToWake = xConstTickCount + xTicksToWait;
 
+		#if( configUSE_64_BIT_TICKS == 1 )
+		{
+			/* The tick count itself never overflows, so only a block time close
+			to portMAX_DELAY can, and such a task is never woken. */
+			if( xTimeToWake < xConstTickCount )
+			{
+				xTimeToWake = portMAX_DELAY;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_64_BIT_TICKS */
+
 		/* The list item will be inserted in wake time order. */
 		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+		#if( configUSE_64_BIT_TICKS == 0 )
 		if( xTimeToWake < xConstTickCount )
 		{
 			/* Wake time has overflowed.  Place this item in the overflow list. */
 			vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 		}
 		else
+		#endif /* configUSE_64_BIT_TICKS */
 		{
 			/* The wake time has not overflowed, so the current block list is used. */
 			vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
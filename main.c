@@ -61,7 +61,9 @@
 #define T8_Period 6
 #define T8_Deadline 6
 
-/* taskSet 4 */
+/* taskSet 4 - over-utilised on purpose.  Tasks 9 and 10 are admitted, and
+ * task 11 would raise the utilisation above 1, so xTaskCreate_EDF() rejects
+ * it and the demo prints "vTask11 rejected" to show admission control. */
 #define T9_Computation 4
 #define T9_Period 12
 #define T9_Deadline 12
@@ -74,18 +76,11 @@
 #define T11_Period 6
 #define T11_Deadline 6
 
-
-int NumberOfPeriodT1 = 1;
-int NumberOfPeriodT2 = 1;
-int NumberOfPeriodT3 = 1;
-int NumberOfPeriodT4 = 1;
-int NumberOfPeriodT5 = 1;
-int NumberOfPeriodT6 = 1;
-int NumberOfPeriodT7 = 1;
-int NumberOfPeriodT8 = 1;
-int NumberOfPeriodT9 = 1;
-int NumberOfPeriodT10 = 1;
-int NumberOfPeriodT11 = 1;
+/* Constant Bandwidth Server for aperiodic work, added to taskSet 4 */
+#define TS_Budget 1
+#define TS_Period 4
+#define TS_Burst 2
+#define TS_Interval 10
 
 /* --------------------------------------------- */
 
@@ -100,8 +95,11 @@ void vTask8(void* /* parameter */);
 void vTask9(void* /* parameter */);
 void vTask10(void* /* parameter */);
 void vTask11(void* /* parameter */);
+void vTaskServer(void* /* parameter */);
 
+void vCreateTask_EDF(TaskFunction_t pxTaskCode, const char * const pcName, int period, int deadline, int computation);
 void vApplicationIdleHook(void);
+void vApplicationDeadlineMissHook(TaskHandle_t xTask, TickType_t xDeadline);
 
 
 
@@ -151,14 +149,12 @@ void vTask4(void* parameter)
 #else
 void vTask1(void* /* parameter */)
 {
-	TickType_t xLastWakeTime = 0;
-	const TickType_t xFrequency = TickScalar * T1_Period; //tsk 1 frequency
+	TaskJobStatus_t xJob;
 	volatile int ct = TickScalar * T1_Computation;	 //tsk 1 computation time
 	while(1)
-	{	
-		// int tickTime_prev = xTaskGetTickCount();
-		int tickTime_start = T1_Period * (NumberOfPeriodT1 - 1);
-		
+	{
+		vTaskGetJobStatus_EDF(NULL, &xJob);
+
 		TickType_t xTime = xTaskGetTickCount();
 		TickType_t x;
 		while(ct != 0)
@@ -169,25 +165,20 @@ void vTask1(void* /* parameter */)
 				ct--;
 			}
 		}
-		// int tickTime_current = xTaskGetTickCount();
-		int tickTime_deadline = T1_Period * NumberOfPeriodT1;
 
-		printf("Task 1 start %5d  |  end %5d\n", tickTime_start, tickTime_deadline);
-		NumberOfPeriodT1 += 1;
+		printf("Task 1 start %5d  |  end %5d  |  missed %3u\n", (int)(xJob.xRelease / TickScalar), (int)(xJob.xDeadline / TickScalar), (unsigned)xJob.uxDeadlineMisses);
 		ct = TickScalar * T1_Computation;
-		vTaskDelayUntil(&xLastWakeTime, xFrequency);
+		vTaskWaitForNextJob_EDF();
 	}
 }
 void vTask2(void* /* parameter */)
 {
-	TickType_t xLastWakeTime = 0;
-	const TickType_t xFrequency = TickScalar * T2_Period; //tsk 2 frequency
+	TaskJobStatus_t xJob;
 	volatile int ct = TickScalar * T2_Computation;	 //tsk 2 computation time
 	while(1)
 	{
-		// int tickTime_prev = xTaskGetTickCount();
-		int tickTime_start = T2_Period * (NumberOfPeriodT2 - 1);
-		
+		vTaskGetJobStatus_EDF(NULL, &xJob);
+
 		TickType_t xTime = xTaskGetTickCount();
 		TickType_t x;
 		while(ct != 0)
@@ -198,25 +189,20 @@ void vTask2(void* /* parameter */)
 				ct--;
 			}
 		}
-		// int tickTime_current = xTaskGetTickCount();
-		int tickTime_deadline = T2_Period * NumberOfPeriodT2;
 
-		printf("Task 2 start %5d  |  end %5d\n", tickTime_start, tickTime_deadline);
-		NumberOfPeriodT2 += 1;
+		printf("Task 2 start %5d  |  end %5d  |  missed %3u\n", (int)(xJob.xRelease / TickScalar), (int)(xJob.xDeadline / TickScalar), (unsigned)xJob.uxDeadlineMisses);
 		ct = TickScalar * T2_Computation;
-		vTaskDelayUntil(&xLastWakeTime, xFrequency);
+		vTaskWaitForNextJob_EDF();
 	}
 }
 void vTask3(void* /* parameter */)
 {
-	TickType_t xLastWakeTime = 0;
-	const TickType_t xFrequency = TickScalar * T3_Period; //tsk 3 frequency
+	TaskJobStatus_t xJob;
 	volatile int ct = TickScalar * T3_Computation;	 //tsk 3 computation time
 	while(1)
 	{
-		// int tickTime_prev = xTaskGetTickCount();
-		int tickTime_start = T3_Period * (NumberOfPeriodT3 - 1);
-		
+		vTaskGetJobStatus_EDF(NULL, &xJob);
+
 		TickType_t xTime = xTaskGetTickCount();
 		TickType_t x;
 		while(ct != 0)
@@ -227,24 +213,20 @@ void vTask3(void* /* parameter */)
 				ct--;
 			}
 		}
-		// int tickTime_current = xTaskGetTickCount();
-		int tickTime_deadline = T3_Period * NumberOfPeriodT3;
 
-		printf("Task 3 start %5d  |  end %5d\n", tickTime_start, tickTime_deadline);
-		NumberOfPeriodT3 += 1;
+		printf("Task 3 start %5d  |  end %5d  |  missed %3u\n", (int)(xJob.xRelease / TickScalar), (int)(xJob.xDeadline / TickScalar), (unsigned)xJob.uxDeadlineMisses);
 		ct = TickScalar * T3_Computation;
-		vTaskDelayUntil(&xLastWakeTime, xFrequency);
+		vTaskWaitForNextJob_EDF();
 	}
 }
 void vTask4(void* /* parameter */)
 {
-	TickType_t xLastWakeTime = 0;
-	const TickType_t xFrequency = TickScalar * T4_Period;
-	volatile int ct = TickScalar * T4_Computation;
+	TaskJobStatus_t xJob;
+	volatile int ct = TickScalar * T4_Computation;	 //tsk 4 computation time
 	while(1)
 	{
-		int tickTime_start = T4_Period * (NumberOfPeriodT4 - 1);
-		
+		vTaskGetJobStatus_EDF(NULL, &xJob);
+
 		TickType_t xTime = xTaskGetTickCount();
 		TickType_t x;
 		while(ct != 0)
@@ -255,23 +237,20 @@ void vTask4(void* /* parameter */)
 				ct--;
 			}
 		}
-		int tickTime_deadline = T4_Period * NumberOfPeriodT4;
 
-		printf("Task 4 start %5d  |  end %5d\n", tickTime_start, tickTime_deadline);
-		NumberOfPeriodT4 += 1;
+		printf("Task 4 start %5d  |  end %5d  |  missed %3u\n", (int)(xJob.xRelease / TickScalar), (int)(xJob.xDeadline / TickScalar), (unsigned)xJob.uxDeadlineMisses);
 		ct = TickScalar * T4_Computation;
-		vTaskDelayUntil(&xLastWakeTime, xFrequency);
+		vTaskWaitForNextJob_EDF();
 	}
 }
 void vTask5(void* /* parameter */)
 {
-	TickType_t xLastWakeTime = 0;
-	const TickType_t xFrequency = TickScalar * T5_Period;
-	volatile int ct = TickScalar * T5_Computation;
+	TaskJobStatus_t xJob;
+	volatile int ct = TickScalar * T5_Computation;	 //tsk 5 computation time
 	while(1)
 	{
-		int tickTime_start = T5_Period * (NumberOfPeriodT5 - 1);
-		
+		vTaskGetJobStatus_EDF(NULL, &xJob);
+
 		TickType_t xTime = xTaskGetTickCount();
 		TickType_t x;
 		while(ct != 0)
@@ -282,23 +261,20 @@ void vTask5(void* /* parameter */)
 				ct--;
 			}
 		}
-		int tickTime_deadline = T5_Period * NumberOfPeriodT5;
 
-		printf("Task 5 start %5d  |  end %5d\n", tickTime_start, tickTime_deadline);
-		NumberOfPeriodT5 += 1;
+		printf("Task 5 start %5d  |  end %5d  |  missed %3u\n", (int)(xJob.xRelease / TickScalar), (int)(xJob.xDeadline / TickScalar), (unsigned)xJob.uxDeadlineMisses);
 		ct = TickScalar * T5_Computation;
-		vTaskDelayUntil(&xLastWakeTime, xFrequency);
+		vTaskWaitForNextJob_EDF();
 	}
 }
 void vTask6(void* /* parameter */)
 {
-	TickType_t xLastWakeTime = 0;
-	const TickType_t xFrequency = TickScalar * T6_Period;
-	volatile int ct = TickScalar * T6_Computation;
+	TaskJobStatus_t xJob;
+	volatile int ct = TickScalar * T6_Computation;	 //tsk 6 computation time
 	while(1)
 	{
-		int tickTime_start = T6_Period * (NumberOfPeriodT6 - 1);
-		
+		vTaskGetJobStatus_EDF(NULL, &xJob);
+
 		TickType_t xTime = xTaskGetTickCount();
 		TickType_t x;
 		while(ct != 0)
@@ -309,23 +285,20 @@ void vTask6(void* /* parameter */)
 				ct--;
 			}
 		}
-		int tickTime_deadline = T6_Period * NumberOfPeriodT6;
 
-		printf("Task 6 start %5d  |  end %5d\n", tickTime_start, tickTime_deadline);
-		NumberOfPeriodT6 += 1;
+		printf("Task 6 start %5d  |  end %5d  |  missed %3u\n", (int)(xJob.xRelease / TickScalar), (int)(xJob.xDeadline / TickScalar), (unsigned)xJob.uxDeadlineMisses);
 		ct = TickScalar * T6_Computation;
-		vTaskDelayUntil(&xLastWakeTime, xFrequency);
+		vTaskWaitForNextJob_EDF();
 	}
 }
 void vTask7(void* /* parameter */)
 {
-	TickType_t xLastWakeTime = 0;
-	const TickType_t xFrequency = TickScalar * T7_Period;
-	volatile int ct = TickScalar * T7_Computation;
+	TaskJobStatus_t xJob;
+	volatile int ct = TickScalar * T7_Computation;	 //tsk 7 computation time
 	while(1)
 	{
-		int tickTime_start = T7_Period * (NumberOfPeriodT7 - 1);
-		
+		vTaskGetJobStatus_EDF(NULL, &xJob);
+
 		TickType_t xTime = xTaskGetTickCount();
 		TickType_t x;
 		while(ct != 0)
@@ -336,23 +309,20 @@ void vTask7(void* /* parameter */)
 				ct--;
 			}
 		}
-		int tickTime_deadline = T7_Period * NumberOfPeriodT7;
 
-		printf("Task 7 start %5d  |  end %5d\n", tickTime_start, tickTime_deadline);
-		NumberOfPeriodT7 += 1;
+		printf("Task 7 start %5d  |  end %5d  |  missed %3u\n", (int)(xJob.xRelease / TickScalar), (int)(xJob.xDeadline / TickScalar), (unsigned)xJob.uxDeadlineMisses);
 		ct = TickScalar * T7_Computation;
-		vTaskDelayUntil(&xLastWakeTime, xFrequency);
+		vTaskWaitForNextJob_EDF();
 	}
 }
 void vTask8(void* /* parameter */)
 {
-	TickType_t xLastWakeTime = 0;
-	const TickType_t xFrequency = TickScalar * T8_Period;
-	volatile int ct = TickScalar * T8_Computation;
+	TaskJobStatus_t xJob;
+	volatile int ct = TickScalar * T8_Computation;	 //tsk 8 computation time
 	while(1)
 	{
-		int tickTime_start = T8_Period * (NumberOfPeriodT8 - 1);
-		
+		vTaskGetJobStatus_EDF(NULL, &xJob);
+
 		TickType_t xTime = xTaskGetTickCount();
 		TickType_t x;
 		while(ct != 0)
@@ -363,23 +333,20 @@ void vTask8(void* /* parameter */)
 				ct--;
 			}
 		}
-		int tickTime_deadline = T8_Period * NumberOfPeriodT8;
 
-		printf("Task 8 start %5d  |  end %5d\n", tickTime_start, tickTime_deadline);
-		NumberOfPeriodT8 += 1;
+		printf("Task 8 start %5d  |  end %5d  |  missed %3u\n", (int)(xJob.xRelease / TickScalar), (int)(xJob.xDeadline / TickScalar), (unsigned)xJob.uxDeadlineMisses);
 		ct = TickScalar * T8_Computation;
-		vTaskDelayUntil(&xLastWakeTime, xFrequency);
+		vTaskWaitForNextJob_EDF();
 	}
 }
 void vTask9(void* /* parameter */)
 {
-	TickType_t xLastWakeTime = 0;
-	const TickType_t xFrequency = TickScalar * T9_Period;
-	volatile int ct = TickScalar * T9_Computation;
+	TaskJobStatus_t xJob;
+	volatile int ct = TickScalar * T9_Computation;	 //tsk 9 computation time
 	while(1)
 	{
-		int tickTime_start = T9_Period * (NumberOfPeriodT9 - 1);
-		
+		vTaskGetJobStatus_EDF(NULL, &xJob);
+
 		TickType_t xTime = xTaskGetTickCount();
 		TickType_t x;
 		while(ct != 0)
@@ -390,23 +357,20 @@ void vTask9(void* /* parameter */)
 				ct--;
 			}
 		}
-		int tickTime_deadline = T9_Period * NumberOfPeriodT9;
 
-		printf("Task 9 start %5d  |  end %5d\n", tickTime_start, tickTime_deadline);
-		NumberOfPeriodT9 += 1;
+		printf("Task 9 start %5d  |  end %5d  |  missed %3u\n", (int)(xJob.xRelease / TickScalar), (int)(xJob.xDeadline / TickScalar), (unsigned)xJob.uxDeadlineMisses);
 		ct = TickScalar * T9_Computation;
-		vTaskDelayUntil(&xLastWakeTime, xFrequency);
+		vTaskWaitForNextJob_EDF();
 	}
 }
 void vTask10(void* /* parameter */)
 {
-	TickType_t xLastWakeTime = 0;
-	const TickType_t xFrequency = TickScalar * T10_Period;
-	volatile int ct = TickScalar * T10_Computation;
+	TaskJobStatus_t xJob;
+	volatile int ct = TickScalar * T10_Computation;	 //tsk 10 computation time
 	while(1)
 	{
-		int tickTime_start = T10_Period * (NumberOfPeriodT10 - 1);
-		
+		vTaskGetJobStatus_EDF(NULL, &xJob);
+
 		TickType_t xTime = xTaskGetTickCount();
 		TickType_t x;
 		while(ct != 0)
@@ -417,23 +381,20 @@ void vTask10(void* /* parameter */)
 				ct--;
 			}
 		}
-		int tickTime_deadline = T10_Period * NumberOfPeriodT10;
 
-		printf("Task 10 start %5d  |  end %5d\n", tickTime_start, tickTime_deadline);
-		NumberOfPeriodT10 += 1;
+		printf("Task 10 start %5d  |  end %5d  |  missed %3u\n", (int)(xJob.xRelease / TickScalar), (int)(xJob.xDeadline / TickScalar), (unsigned)xJob.uxDeadlineMisses);
 		ct = TickScalar * T10_Computation;
-		vTaskDelayUntil(&xLastWakeTime, xFrequency);
+		vTaskWaitForNextJob_EDF();
 	}
 }
 void vTask11(void* /* parameter */)
 {
-	TickType_t xLastWakeTime = 0;
-	const TickType_t xFrequency = TickScalar * T11_Period;
-	volatile int ct = TickScalar * T11_Computation;
+	TaskJobStatus_t xJob;
+	volatile int ct = TickScalar * T11_Computation;	 //tsk 11 computation time
 	while(1)
 	{
-		int tickTime_start = T11_Period * (NumberOfPeriodT11 - 1);
-		
+		vTaskGetJobStatus_EDF(NULL, &xJob);
+
 		TickType_t xTime = xTaskGetTickCount();
 		TickType_t x;
 		while(ct != 0)
@@ -444,20 +405,65 @@ void vTask11(void* /* parameter */)
 				ct--;
 			}
 		}
-		int tickTime_deadline = T11_Period * NumberOfPeriodT11;
 
-		printf("Task 11 start %5d  |  end %5d\n", tickTime_start, tickTime_deadline);
-		NumberOfPeriodT11 += 1;
+		printf("Task 11 start %5d  |  end %5d  |  missed %3u\n", (int)(xJob.xRelease / TickScalar), (int)(xJob.xDeadline / TickScalar), (unsigned)xJob.uxDeadlineMisses);
 		ct = TickScalar * T11_Computation;
-		vTaskDelayUntil(&xLastWakeTime, xFrequency);
+		vTaskWaitForNextJob_EDF();
+	}
+}
+/* Aperiodic work: a burst longer than the server budget every TS_Interval.
+ * The server stretches the burst over several server periods instead of
+ * delaying the periodic tasks. */
+void vTaskServer(void* /* parameter */)
+{
+	volatile int ct = TickScalar * TS_Burst;
+	while(1)
+	{
+		int tickTime_start = xTaskGetTickCount();
+
+		TickType_t xTime = xTaskGetTickCount();
+		TickType_t x;
+		while(ct != 0)
+		{
+			if((x = xTaskGetTickCount()) > xTime)
+			{
+				xTime = x;
+				ct--;
+			}
+		}
+
+		printf("Server burst start %5d  |  end %5d\n", tickTime_start / TickScalar, (int)(xTaskGetTickCount() / TickScalar));
+		ct = TickScalar * TS_Burst;
+		vTaskDelay(TickScalar * TS_Interval);
 	}
 }
 #endif
 
+#if ( configUSE_EDF_SCHEDULER == 1 )
+void vCreateTask_EDF(TaskFunction_t pxTaskCode, const char * const pcName, int period, int deadline, int computation)
+{
+	BaseType_t xReturn = xTaskCreate_EDF( pxTaskCode, pcName, configMINIMAL_STACK_SIZE, NULL, 1, NULL, TickScalar * period, TickScalar * deadline, TickScalar * computation);
+
+	if (xReturn == errTASK_NOT_SCHEDULABLE)
+		printf("%s rejected: the task set would not be schedulable\n", pcName);
+}
+#endif
+
 void vApplicationIdleHook(void)
 {
 //	printf("Idle\r\n");
 }
+
+/* Called from the tick interrupt, so only record the miss here. Each task
+ * reports its own miss count through vTaskGetJobStatus_EDF(). */
+volatile UBaseType_t uxTotalDeadlineMisses = 0;
+
+void vApplicationDeadlineMissHook(TaskHandle_t xTask, TickType_t xDeadline)
+{
+	(void)xTask;
+	(void)xDeadline;
+	uxTotalDeadlineMisses++;
+}
 /*-----------------------------------------------------------*/
 
 int main ( void )
@@ -470,20 +476,22 @@ int main ( void )
 	/* Creating Task with EDF Scheduling*/
 	#if ( configUSE_EDF_SCHEDULER == 1 )
 		#if ( taskSet_1 == 1 )
-			xTaskCreate_EDF( vTask1, "vTask1", configMINIMAL_STACK_SIZE, NULL, 1, NULL, T1_Period , T1_Deadline);
-			xTaskCreate_EDF( vTask2, "vTask2", configMINIMAL_STACK_SIZE, NULL, 1, NULL, T2_Period , T2_Deadline);
+			vCreateTask_EDF( vTask1, "vTask1", T1_Period, T1_Deadline, T1_Computation );
+			vCreateTask_EDF( vTask2, "vTask2", T2_Period, T2_Deadline, T2_Computation );
 		#elif ( taskSet_2 == 1 )
-			xTaskCreate_EDF( vTask3, "vTask3", configMINIMAL_STACK_SIZE, NULL, 1, NULL, T3_Period , T3_Deadline);
-			xTaskCreate_EDF( vTask4, "vTask4", configMINIMAL_STACK_SIZE, NULL, 1, NULL, T4_Period , T4_Deadline);
-			xTaskCreate_EDF( vTask5, "vTask5", configMINIMAL_STACK_SIZE, NULL, 1, NULL, T5_Period , T5_Deadline);
+			vCreateTask_EDF( vTask3, "vTask3", T3_Period, T3_Deadline, T3_Computation );
+			vCreateTask_EDF( vTask4, "vTask4", T4_Period, T4_Deadline, T4_Computation );
+			vCreateTask_EDF( vTask5, "vTask5", T5_Period, T5_Deadline, T5_Computation );
 		#elif ( taskSet_3 == 1 )
-			xTaskCreate_EDF( vTask6, "vTask6", configMINIMAL_STACK_SIZE, NULL, 1, NULL, T6_Period , T6_Deadline);
-			xTaskCreate_EDF( vTask7, "vTask7", configMINIMAL_STACK_SIZE, NULL, 1, NULL, T7_Period , T7_Deadline);
-			xTaskCreate_EDF( vTask8, "vTask8", configMINIMAL_STACK_SIZE, NULL, 1, NULL, T8_Period , T8_Deadline);
+			vCreateTask_EDF( vTask6, "vTask6", T6_Period, T6_Deadline, T6_Computation );
+			vCreateTask_EDF( vTask7, "vTask7", T7_Period, T7_Deadline, T7_Computation );
+			vCreateTask_EDF( vTask8, "vTask8", T8_Period, T8_Deadline, T8_Computation );
 		#elif ( taskSet_4 == 1 )
-			xTaskCreate_EDF( vTask9, "vTask9", configMINIMAL_STACK_SIZE, NULL, 1, NULL, T9_Period , T9_Deadline);
-			xTaskCreate_EDF( vTask10, "vTask10", configMINIMAL_STACK_SIZE, NULL, 1, NULL, T10_Period , T10_Deadline);
-			xTaskCreate_EDF( vTask11, "vTask11", configMINIMAL_STACK_SIZE, NULL, 1, NULL, T11_Period , T11_Deadline);
+			vCreateTask_EDF( vTask9, "vTask9", T9_Period, T9_Deadline, T9_Computation );
+			vCreateTask_EDF( vTask10, "vTask10", T10_Period, T10_Deadline, T10_Computation );
+			vCreateTask_EDF( vTask11, "vTask11", T11_Period, T11_Deadline, T11_Computation );
+			if (xTaskCreate_CBS( vTaskServer, "vTaskServer", configMINIMAL_STACK_SIZE, NULL, 1, NULL, TickScalar * TS_Budget, TickScalar * TS_Period) == errTASK_NOT_SCHEDULABLE)
+				printf("vTaskServer rejected: the task set would not be schedulable\n");
 		#endif
 	#else
     /* Creating Task Same Priorities and Delay*/